@@ -2,7 +2,7 @@
 VERSION = 0.1
 
 # core modules to include
-CORE = core/core.c core/string.c core/math.c core/io.c core/os.c
+CORE = core/core.c core/list.c core/vec.c core/map.c core/array.c core/string.c core/regex.c core/math.c core/io.c core/os.c
 EVO = core/core.evo core/list.evo core/doc.evo core/io.evo core/math.evo core/os.evo
 
 # paths
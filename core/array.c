@@ -0,0 +1,358 @@
+/* zlib License
+ *
+ * Copyright (c) 2017-2025 Ed van Bruggen
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+#include <math.h>
+
+/* Number arrays store decimals unboxed and contiguously. The kernels below are
+ * plain loops over restrict pointers, with reductions split across independent
+ * accumulators, so the compiler can vectorize them using whichever SIMD
+ * instructions the target it is building for supports. */
+
+/* set IDX to index I of array A, counting from end if negative */
+#define ARR_INDEX(NAME, A, I, IDX) do {                                          \
+	eevo_arg_type(A, NAME, EEVO_NUMARR);                                     \
+	VEC_INDEX(NAME, I, IDX, A->v.na.len);                                    \
+} while(0)
+
+/* element-wise arithmetic between two arrays, array and number, or number and array */
+#define ARR_KERNEL(NAME, OP)                                                          \
+static void                                                                           \
+arr_##NAME(double *restrict r, const double *restrict a, const double *restrict b, int n) \
+{                                                                                     \
+	for (int i = 0; i < n; i++)                                                   \
+		r[i] = a[i] OP b[i];                                                  \
+}                                                                                     \
+static void                                                                           \
+arr_##NAME##_an(double *restrict r, const double *restrict a, double b, int n)        \
+{                                                                                     \
+	for (int i = 0; i < n; i++)                                                   \
+		r[i] = a[i] OP b;                                                     \
+}                                                                                     \
+static void                                                                           \
+arr_##NAME##_na(double *restrict r, double a, const double *restrict b, int n)        \
+{                                                                                     \
+	for (int i = 0; i < n; i++)                                                   \
+		r[i] = a OP b[i];                                                     \
+}
+
+ARR_KERNEL(add, +)
+ARR_KERNEL(sub, -)
+ARR_KERNEL(mul, *)
+ARR_KERNEL(div, /)
+
+static double
+arr_sum(const double *restrict a, int n)
+{
+	double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	int i;
+	for (i = 0; i + 4 <= n; i += 4) {
+		s0 += a[i];
+		s1 += a[i+1];
+		s2 += a[i+2];
+		s3 += a[i+3];
+	}
+	for (; i < n; i++)
+		s0 += a[i];
+	return (s0 + s1) + (s2 + s3);
+}
+
+static double
+arr_dot(const double *restrict a, const double *restrict b, int n)
+{
+	double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	int i;
+	for (i = 0; i + 4 <= n; i += 4) {
+		s0 += a[i]   * b[i];
+		s1 += a[i+1] * b[i+1];
+		s2 += a[i+2] * b[i+2];
+		s3 += a[i+3] * b[i+3];
+	}
+	for (; i < n; i++)
+		s0 += a[i] * b[i];
+	return (s0 + s1) + (s2 + s3);
+}
+
+static double
+arr_min(const double *restrict a, int n)
+{
+	double m = a[0];
+	for (int i = 1; i < n; i++)
+		m = a[i] < m ? a[i] : m;
+	return m;
+}
+
+static double
+arr_max(const double *restrict a, int n)
+{
+	double m = a[0];
+	for (int i = 1; i < n; i++)
+		m = a[i] > m ? a[i] : m;
+	return m;
+}
+
+/* store decimal value of number in array */
+#define ARR_NUM(V) (num(V) / den(V))
+
+/* create new number array from given numbers */
+static Eevo
+prim_NumArray(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret = eevo_numarr(abs(eevo_lstlen(args)));
+	for (int i = 0; args->t == EEVO_PAIR; args = rst(args), i++) {
+		eevo_arg_type(fst(args), "NumArray", EEVO_NUM);
+		ret->v.na.d[i] = ARR_NUM(fst(args));
+	}
+	return ret;
+}
+
+/* create new number array from list or vector of numbers */
+static Eevo
+prim_arrfrom(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo seq, v, ret;
+	int i = 0, c = 0, len;
+	eevo_arg_num(args, "arr-from", 1);
+	seq = fst(args);
+	eevo_arg_type(seq, "arr-from", EEVO_LIST | EEVO_VEC | EEVO_PVEC | EEVO_NUMARR);
+	len = seq->t == EEVO_VEC ? seq->v.vec.len : seq->t == EEVO_PVEC ? seq->v.pv.len :
+	      seq->t == EEVO_NUMARR ? seq->v.na.len : abs(eevo_lstlen(seq));
+	ret = eevo_numarr(len);
+	while (seq_next(&seq, &i, &v)) {
+		eevo_arg_type(v, "arr-from", EEVO_NUM);
+		ret->v.na.d[c++] = ARR_NUM(v);
+	}
+	return ret;
+}
+
+/* create new number array of given length filled with a number */
+static Eevo
+prim_arrfill(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret;
+	double x;
+	eevo_arg_num(args, "arr-fill", 2);
+	eevo_arg_type(fst(args), "arr-fill", EEVO_INT);
+	eevo_arg_type(snd(args), "arr-fill", EEVO_NUM);
+	if (num(fst(args)) < 0)
+		eevo_warn("arr-fill: expected non-negative length");
+	ret = eevo_numarr(num(fst(args)));
+	x = ARR_NUM(snd(args));
+	for (int i = 0; i < ret->v.na.len; i++)
+		ret->v.na.d[i] = x;
+	return ret;
+}
+
+/* create new number array counting from start to end, inclusive */
+static Eevo
+prim_arrrange(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret;
+	double a, b;
+	eevo_arg_num(args, "arr-range", 2);
+	eevo_arg_type(fst(args), "arr-range", EEVO_NUM);
+	eevo_arg_type(snd(args), "arr-range", EEVO_NUM);
+	a = ARR_NUM(fst(args)), b = ARR_NUM(snd(args));
+	ret = eevo_numarr(b >= a ? (int)(b - a) + 1 : 0);
+	for (int i = 0; i < ret->v.na.len; i++)
+		ret->v.na.d[i] = a + i;
+	return ret;
+}
+
+/* return element of array at index */
+static Eevo
+prim_arrref(EevoSt st, EevoRec env, Eevo args)
+{
+	int i;
+	eevo_arg_num(args, "arr-ref", 2);
+	ARR_INDEX("arr-ref", fst(args), snd(args), i);
+	return eevo_dec(fst(args)->v.na.d[i]);
+}
+
+/* replace element of array at index */
+static Eevo
+prim_arrset(EevoSt st, EevoRec env, Eevo args)
+{
+	int i;
+	eevo_arg_num(args, "arr-set!", 3);
+	ARR_INDEX("arr-set!", fst(args), snd(args), i);
+	eevo_arg_type(fst(rrst(args)), "arr-set!", EEVO_NUM);
+	fst(args)->v.na.d[i] = ARR_NUM(fst(rrst(args)));
+	return Void;
+}
+
+/* return number of elements in array */
+static Eevo
+prim_arrlen(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "arr-len", 1);
+	eevo_arg_type(fst(args), "arr-len", EEVO_NUMARR);
+	return eevo_int(fst(args)->v.na.len);
+}
+
+/* return list of elements in array */
+static Eevo
+prim_arrlist(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo a, ret = Nil;
+	eevo_arg_num(args, "arr-list", 1);
+	a = fst(args);
+	eevo_arg_type(a, "arr-list", EEVO_NUMARR);
+	for (int i = a->v.na.len - 1; i >= 0; i--)
+		ret = eevo_pair(eevo_dec(a->v.na.d[i]), ret);
+	return ret;
+}
+
+/* element-wise arithmetic, either argument can be a single number */
+#define PRIM_ARR_OP(NAME)                                                       \
+static Eevo                                                                     \
+prim_arr##NAME(EevoSt st, EevoRec env, Eevo args)                               \
+{                                                                               \
+	Eevo a, b, ret;                                                         \
+	eevo_arg_num(args, "arr-" #NAME, 2);                                    \
+	a = fst(args), b = snd(args);                                           \
+	eevo_arg_type(a, "arr-" #NAME, EEVO_NUMARR | EEVO_NUM);                 \
+	eevo_arg_type(b, "arr-" #NAME, EEVO_NUMARR | EEVO_NUM);                 \
+	if (a->t == EEVO_NUMARR && b->t == EEVO_NUMARR) {                       \
+		if (a->v.na.len != b->v.na.len)                                 \
+			eevo_warnf("arr-" #NAME ": expected arrays of same length, " \
+			           "received %d and %d", a->v.na.len, b->v.na.len); \
+		ret = eevo_numarr(a->v.na.len);                                 \
+		arr_##NAME(ret->v.na.d, a->v.na.d, b->v.na.d, a->v.na.len);     \
+	} else if (a->t == EEVO_NUMARR) {                                       \
+		ret = eevo_numarr(a->v.na.len);                                 \
+		arr_##NAME##_an(ret->v.na.d, a->v.na.d, ARR_NUM(b), a->v.na.len); \
+	} else if (b->t == EEVO_NUMARR) {                                       \
+		ret = eevo_numarr(b->v.na.len);                                 \
+		arr_##NAME##_na(ret->v.na.d, ARR_NUM(a), b->v.na.d, b->v.na.len); \
+	} else                                                                  \
+		eevo_warn("arr-" #NAME ": expected at least one NumArray");     \
+	return ret;                                                             \
+}
+
+PRIM_ARR_OP(add)
+PRIM_ARR_OP(sub)
+PRIM_ARR_OP(mul)
+PRIM_ARR_OP(div)
+
+/* reduction of array to single number, which can require it to be non-empty */
+#define PRIM_ARR_REDUCE(NAME, NONEMPTY, EXPR)                            \
+static Eevo                                                              \
+prim_arr##NAME(EevoSt st, EevoRec env, Eevo args)                        \
+{                                                                        \
+	Eevo a;                                                          \
+	eevo_arg_num(args, "arr-" #NAME, 1);                             \
+	a = fst(args);                                                   \
+	eevo_arg_type(a, "arr-" #NAME, EEVO_NUMARR);                     \
+	if (NONEMPTY && !a->v.na.len)                                    \
+		eevo_warn("arr-" #NAME ": expected non-empty NumArray"); \
+	return eevo_dec(EXPR);                                           \
+}
+
+PRIM_ARR_REDUCE(sum,  0, arr_sum(a->v.na.d, a->v.na.len))
+PRIM_ARR_REDUCE(min,  1, arr_min(a->v.na.d, a->v.na.len))
+PRIM_ARR_REDUCE(max,  1, arr_max(a->v.na.d, a->v.na.len))
+PRIM_ARR_REDUCE(mean, 1, arr_sum(a->v.na.d, a->v.na.len) / a->v.na.len)
+
+/* sum of products of each pair of elements */
+static Eevo
+prim_arrdot(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo a, b;
+	eevo_arg_num(args, "arr-dot", 2);
+	a = fst(args), b = snd(args);
+	eevo_arg_type(a, "arr-dot", EEVO_NUMARR);
+	eevo_arg_type(b, "arr-dot", EEVO_NUMARR);
+	if (a->v.na.len != b->v.na.len)
+		eevo_warnf("arr-dot: expected arrays of same length, received %d and %d",
+		           a->v.na.len, b->v.na.len);
+	return eevo_dec(arr_dot(a->v.na.d, b->v.na.d, a->v.na.len));
+}
+
+/* apply math function to each element, same set as trigonometric primitives */
+#define PRIM_ARR_MATH(NAME)                                          \
+static Eevo                                                          \
+prim_arr##NAME(EevoSt st, EevoRec env, Eevo args)                    \
+{                                                                    \
+	Eevo a, ret;                                                 \
+	eevo_arg_num(args, "arr-" #NAME, 1);                         \
+	a = fst(args);                                               \
+	eevo_arg_type(a, "arr-" #NAME, EEVO_NUMARR);                 \
+	ret = eevo_numarr(a->v.na.len);                              \
+	for (int i = 0; i < a->v.na.len; i++)                        \
+		ret->v.na.d[i] = NAME(a->v.na.d[i]);                 \
+	return ret;                                                  \
+}
+
+PRIM_ARR_MATH(sin)
+PRIM_ARR_MATH(cos)
+PRIM_ARR_MATH(tan)
+PRIM_ARR_MATH(sinh)
+PRIM_ARR_MATH(cosh)
+PRIM_ARR_MATH(tanh)
+PRIM_ARR_MATH(asin)
+PRIM_ARR_MATH(acos)
+PRIM_ARR_MATH(atan)
+PRIM_ARR_MATH(asinh)
+PRIM_ARR_MATH(acosh)
+PRIM_ARR_MATH(atanh)
+PRIM_ARR_MATH(exp)
+PRIM_ARR_MATH(log)
+PRIM_ARR_MATH(sqrt)
+PRIM_ARR_MATH(fabs)
+
+void
+eevo_env_array(EevoSt st)
+{
+	st->types[19]->v.t.func = eevo_prim(EEVO_PRIM, prim_NumArray, "NumArray");
+	eevo_env_name_prim(arr-from,   arrfrom);
+	eevo_env_name_prim(arr-fill,   arrfill);
+	eevo_env_name_prim(arr-range,  arrrange);
+	eevo_env_name_prim(arr-ref,    arrref);
+	eevo_env_name_prim(arr-set!,   arrset);
+	eevo_env_name_prim(arr-len,    arrlen);
+	eevo_env_name_prim(arr-list,   arrlist);
+
+	eevo_env_name_prim(arr-add,   arradd);
+	eevo_env_name_prim(arr-sub,   arrsub);
+	eevo_env_name_prim(arr-mul,   arrmul);
+	eevo_env_name_prim(arr-div,   arrdiv);
+	eevo_env_name_prim(arr-sum,    arrsum);
+	eevo_env_name_prim(arr-min,    arrmin);
+	eevo_env_name_prim(arr-max,    arrmax);
+	eevo_env_name_prim(arr-mean,   arrmean);
+	eevo_env_name_prim(arr-dot,    arrdot);
+
+	eevo_env_name_prim(arr-sin,     arrsin);
+	eevo_env_name_prim(arr-cos,     arrcos);
+	eevo_env_name_prim(arr-tan,     arrtan);
+	eevo_env_name_prim(arr-sinh,    arrsinh);
+	eevo_env_name_prim(arr-cosh,    arrcosh);
+	eevo_env_name_prim(arr-tanh,    arrtanh);
+	eevo_env_name_prim(arr-arcsin,  arrasin);
+	eevo_env_name_prim(arr-arccos,  arracos);
+	eevo_env_name_prim(arr-arctan,  arratan);
+	eevo_env_name_prim(arr-arcsinh, arrasinh);
+	eevo_env_name_prim(arr-arccosh, arracosh);
+	eevo_env_name_prim(arr-arctanh, arratanh);
+	eevo_env_name_prim(arr-exp,     arrexp);
+	eevo_env_name_prim(arr-log,     arrlog);
+	eevo_env_name_prim(arr-sqrt,    arrsqrt);
+	eevo_env_name_prim(arr-abs,     arrfabs);
+}
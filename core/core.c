@@ -37,6 +37,39 @@ prim_rst(EevoSt st, EevoRec env, Eevo args)
 	return rfst(args);
 }
 
+/* follow path of f and r from right to left, getting fst or rst of each pair */
+static Eevo
+cxr(Eevo v, char *name, char *path)
+{
+	for (int i = strlen(path) - 1; i >= 0; i--) {
+		if (v->t != EEVO_PAIR)
+			eevo_warnf("%s: expected Pair, received %s", name, eevo_type_str(v->t));
+		v = path[i] == 'f' ? fst(v) : rst(v);
+	}
+	return v;
+}
+
+#define PRIM_CXR(NAME, PATH)                           \
+static Eevo                                            \
+prim_##NAME(EevoSt st, EevoRec env, Eevo args)         \
+{                                                      \
+	eevo_arg_num(args, #NAME, 1);                  \
+	return cxr(fst(args), #NAME, PATH);            \
+}
+
+PRIM_CXR(snd,   "fr")
+PRIM_CXR(ffst,  "ff")
+PRIM_CXR(rfst,  "rf")
+PRIM_CXR(rrst,  "rr")
+PRIM_CXR(fffst, "fff")
+PRIM_CXR(ffrst, "ffr")
+PRIM_CXR(frfst, "frf")
+PRIM_CXR(frrst, "frr")
+PRIM_CXR(rffst, "rff")
+PRIM_CXR(rfrst, "rfr")
+PRIM_CXR(rrfst, "rrf")
+PRIM_CXR(rrrst, "rrr")
+
 /* return new pair */
 static Eevo
 prim_Pair(EevoSt st, EevoRec env, Eevo args)
@@ -59,7 +92,9 @@ prim_eval(EevoSt st, EevoRec env, Eevo args)
 {
 	Eevo v;
 	eevo_arg_num(args, "eval", 1);
-	return (v = eevo_eval(st, st->env, fst(args))) ? v : Void;
+	if (!(v = eevo_eval(st, st->env, fst(args))) && st->tag)
+		return NULL; /* keep unwinding to catch */
+	return v ? v : Void;
 }
 
 /* test equality of all values given */
@@ -88,6 +123,270 @@ form_cond(EevoSt st, EevoRec env, Eevo args)
 	return Void;
 }
 
+/* start loop with frame holding its tag for break, and any variable it binds */
+static EevoRec
+loop_start(EevoSt st, EevoRec env)
+{
+	EevoRec loop = frame_new(st, env);
+	Eevo tag = eevo_val(EEVO_VOID); /* unique to this loop, compared by address */
+	loop->loop = 1;
+	loop->body = NULL;
+	rec_add(loop, EEVO_LOOP_TAG, tag);
+	st->loops = eevo_pair(tag, st->loops);
+	return loop;
+}
+
+/* end loop, returning ret */
+static Eevo
+loop_end(EevoSt st, EevoRec loop, Eevo ret)
+{
+	st->loops = rst(st->loops);
+	frame_release(st, loop);
+	return ret;
+}
+
+/* evaluate body of loop, on break store value given in ret and return 0 */
+static int
+loop_body(EevoSt st, EevoRec loop, Eevo body, Eevo *ret)
+{
+	if (eevo_eval_body(st, loop, body))
+		return 1;
+	*ret = NULL; /* error or throw to outer catch */
+	if (st->tag && st->tag == fst(st->loops)) {
+		*ret = st->thrown;
+		st->tag = st->thrown = NULL;
+	}
+	return 0;
+}
+
+/* test if body could keep value of var after its iteration, which is not the
+ * case if var is only given to comparisons, since they never keep arguments */
+static int
+loop_keeps(EevoRec env, Eevo var, Eevo v)
+{
+	static char *cmps[] = { "=", "<", ">", "<=", ">=", "mod" };
+	Eevo f;
+	if (v->t != EEVO_PAIR)
+		return v == var;
+	if (fst(v)->t == EEVO_SYM && !strcmp(fst(v)->v.s, "quote"))
+		return 0;
+	if (fst(v)->t == EEVO_SYM && (f = rec_get(env, fst(v)->v.s)) && f->t == EEVO_PRIM)
+		for (int i = 0; i < LEN(cmps); i++)
+			if (!strcmp(f->v.pr.name, cmps[i])) {
+				for (v = rst(v); v->t == EEVO_PAIR; v = rst(v))
+					if (fst(v) != var && loop_keeps(env, var, fst(v)))
+						return 1;
+				return 0;
+			}
+	for (; v->t == EEVO_PAIR; v = rst(v))
+		if (loop_keeps(env, var, fst(v)))
+			return 1;
+	return v == var;
+}
+
+/* evaluate body until break is called */
+static Eevo
+form_loop(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret = Void;
+	EevoRec loop = loop_start(st, env);
+	while (loop_body(st, loop, args, &ret)) ;
+	return loop_end(st, loop, ret);
+}
+
+/* evaluate body while condition is true */
+static Eevo
+form_while(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo cond, ret = Void;
+	EevoRec loop;
+	eevo_arg_min(args, "while", 1);
+	loop = loop_start(st, env);
+	while ((cond = eevo_eval(st, loop, fst(args))) && !nilp(cond))
+		if (!loop_body(st, loop, rst(args), &ret))
+			break;
+	return loop_end(st, loop, cond ? ret : NULL);
+}
+
+/* evaluate body for each element of list or integer in inclusive range,
+ * binding it to given variable in frame of loop
+ *   for var in lst ... body
+ *   for var in start .. end ... body */
+static Eevo
+form_for(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo var, lst, end, ret = Void;
+	EevoRec loop;
+	eevo_arg_min(args, "for", 3);
+	var = fst(args);
+	eevo_arg_type(var, "for", EEVO_SYM);
+	if (snd(args)->t != EEVO_SYM || strcmp(snd(args)->v.s, "in"))
+		eevo_warn("for: expected 'in' after variable");
+	args = rrst(args);
+	if (!(lst = eevo_eval(st, env, fst(args))))
+		return NULL;
+	if (rst(args)->t == EEVO_PAIR && snd(args)->t == EEVO_SYM &&
+	    !strcmp(snd(args)->v.s, "..")) { /* counted range, no list is built */
+		Eevo n;
+		EevoEntry e;
+		int keeps;
+		if (rrst(args)->t != EEVO_PAIR)
+			eevo_warn("for: expected end of range after '..'");
+		if (!(end = eevo_eval(st, env, fst(rrst(args)))))
+			return NULL;
+		eevo_arg_type(lst, "for", EEVO_INT);
+		eevo_arg_type(end, "for", EEVO_INT);
+		args = rst(rrst(args));
+		loop = loop_start(st, env);
+		keeps = loop_keeps(env, var, args);
+		rec_add(loop, var->v.s, n = eevo_int(num(lst)));
+		e = &loop->items[loop->size - 1];
+		for (double i = num(lst); i <= num(end); i++) {
+			/* count in one cell unless body could keep its value */
+			if (keeps)
+				e->val = n = eevo_int(i);
+			else
+				n->v.n.num = i;
+			if (!loop_body(st, loop, args, &ret))
+				break;
+		}
+	} else {
+		Eevo v;
+		int i = 0;
+		eevo_arg_type(lst, "for", EEVO_LIST | EEVO_VEC | EEVO_PVEC | EEVO_NUMARR);
+		args = rst(args);
+		loop = loop_start(st, env);
+		while (seq_next(&lst, &i, &v)) {
+			rec_add(loop, var->v.s, v);
+			if (!loop_body(st, loop, args, &ret))
+				break;
+		}
+	}
+	return loop_end(st, loop, ret);
+}
+
+/* exit innermost loop the call is written in, returning given value from it */
+static Eevo
+form_break(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo v = Void, tag, l;
+	eevo_arg_max(args, "break", 1);
+	tag = rec_get(env, EEVO_LOOP_TAG);
+	for (l = st->loops; l->t == EEVO_PAIR && fst(l) != tag; l = rst(l)) ;
+	if (!tag || nilp(l))
+		eevo_warn("break: not inside of loop");
+	if (!nilp(args) && !(v = eevo_eval(st, env, fst(args))))
+		return NULL;
+	st->tag = tag;
+	st->thrown = v;
+	return NULL;
+}
+
+/* evaluate body, returning value given to throw with an equal tag if called
+ *   catch tag ... body */
+static Eevo
+form_catch(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo tag, ret, prev = st->catches;
+	eevo_arg_min(args, "catch", 1);
+	if (!(tag = eevo_eval(st, env, fst(args))))
+		return NULL;
+	st->catches = eevo_pair(tag, prev);
+	ret = eevo_eval_body(st, env, rst(args));
+	st->catches = prev;
+	if (!ret && st->tag && vals_eq(st->tag, tag)) {
+		ret = st->thrown;
+		st->tag = st->thrown = NULL;
+	}
+	return ret;
+}
+
+/* exit to innermost catch with equal tag, which returns given value
+ * frames in between are left without printing errors or recording backtrace */
+static Eevo
+prim_throw(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo c;
+	char *tag;
+	eevo_arg_num(args, "throw", 2);
+	for (c = st->catches; c->t == EEVO_PAIR; c = rst(c))
+		if (vals_eq(fst(c), fst(args)))
+			break;
+	if (nilp(c)) {
+		if (!(tag = eevo_print(fst(args))))
+			return NULL;
+		fprintf(stderr, "; eevo: error: throw: no catch for tag %s\n", tag);
+		free(tag);
+		return NULL;
+	}
+	st->tag = fst(args);
+	st->thrown = snd(args);
+	return NULL;
+}
+
+/* type predicates, test if value is any of the given types */
+#define PRIM_TYPEP(NAME, TYPE)                         \
+static Eevo                                            \
+prim_##NAME##p(EevoSt st, EevoRec env, Eevo args)      \
+{                                                      \
+	eevo_arg_num(args, #NAME "?", 1);              \
+	return fst(args)->t & (TYPE) ? True : Nil;     \
+}
+
+PRIM_TYPEP(void,        EEVO_VOID)
+PRIM_TYPEP(nil,         EEVO_NIL)
+PRIM_TYPEP(integer,     EEVO_INT)
+PRIM_TYPEP(decimal,     EEVO_DEC)
+PRIM_TYPEP(ratio,       EEVO_RATIO)
+PRIM_TYPEP(rational,    EEVO_RATIONAL)
+PRIM_TYPEP(number,      EEVO_NUM)
+PRIM_TYPEP(string,      EEVO_STR | EEVO_STRVIEW)
+PRIM_TYPEP(symbol,      EEVO_SYM)
+PRIM_TYPEP(primitive,   EEVO_PRIM)
+PRIM_TYPEP(specialform, EEVO_FORM)
+PRIM_TYPEP(builtin,     EEVO_PRIM | EEVO_FORM)
+PRIM_TYPEP(function,    EEVO_FUNC)
+PRIM_TYPEP(macro,       EEVO_MACRO)
+PRIM_TYPEP(generic,     EEVO_GEN)
+PRIM_TYPEP(procedure,   EEVO_PROC)
+PRIM_TYPEP(pair,        EEVO_PAIR)
+PRIM_TYPEP(atom,        ~EEVO_PAIR)
+PRIM_TYPEP(record,      EEVO_REC)
+PRIM_TYPEP(vec,         EEVO_VEC)
+PRIM_TYPEP(pvec,        EEVO_PVEC)
+PRIM_TYPEP(map,         EEVO_MAP)
+PRIM_TYPEP(set,         EEVO_SET)
+PRIM_TYPEP(numarray,    EEVO_NUMARR)
+PRIM_TYPEP(numfunc,     EEVO_NUMFN)
+PRIM_TYPEP(strbuf,      EEVO_STRBUF)
+PRIM_TYPEP(rope,        EEVO_ROPE)
+PRIM_TYPEP(strview,     EEVO_STRVIEW)
+PRIM_TYPEP(regex,       EEVO_REGEX)
+
+/* test if value is a proper list, ending with nil */
+static Eevo
+prim_listp(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "list?", 1);
+	return eevo_lstlen(fst(args)) >= 0 ? True : Nil;
+}
+
+/* test if value is the True symbol */
+static Eevo
+prim_truep(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "true?", 1);
+	return fst(args) == True ? True : Nil;
+}
+
+/* test if value is either True or Nil */
+static Eevo
+prim_booleanp(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "boolean?", 1);
+	return fst(args) == True || nilp(fst(args)) ? True : Nil;
+}
+
 /* return type of eevo value */
 static Eevo
 prim_typeof(EevoSt st, EevoRec env, Eevo args)
@@ -102,7 +401,7 @@ prim_procprops(EevoSt st, EevoRec env, Eevo args)
 {
 	eevo_arg_num(args, "procprops", 1);
 	Eevo proc = fst(args);
-	EevoRec ret = rec_new(6, NULL);
+	EevoRec ret = rec_new_linear(NULL);
 	switch (proc->t) {
 	case EEVO_FORM:
 	case EEVO_PRIM:
@@ -115,6 +414,14 @@ prim_procprops(EevoSt st, EevoRec env, Eevo args)
 		rec_add(ret, "body", proc->v.f.body);
 		/* rec_add(ret, "env", proc->v.f.env); */
 		break;
+	case EEVO_GEN:
+		rec_add(ret, "name", eevo_sym(st, proc->v.g->name));
+		rec_add(ret, "args", proc->v.g->args);
+		break;
+	case EEVO_NUMFN:
+		rec_add(ret, "args", proc->v.nf->args);
+		rec_add(ret, "body", proc->v.nf->expr);
+		break;
 	default:
 		eevo_warnf("procprops: expected Proc, received '%s'", eevo_type_str(proc->t));
 	}
@@ -134,7 +441,7 @@ form_Func(EevoSt st, EevoRec env, Eevo args)
 		params = fst(args);
 		body = rst(args);
 	}
-	return eevo_func(EEVO_FUNC, NULL, params, body, env);
+	return eevo_func(EEVO_FUNC, NULL, params, body, closure_env(st, env, params, body, NULL));
 }
 
 /* creates new eevo defined macro */
@@ -164,19 +471,37 @@ prim_error(EevoSt st, EevoRec env, Eevo args)
 
 /** Records **/
 
-/* merge second record into first record, without mutation */
+/* merge second record into first record, without mutation
+ *   small records are copied, otherwise only the path to each changed entry
+ *   of the trie is copied and the rest is shared */
 static Eevo
 prim_recmerge(EevoSt st, EevoRec env, Eevo args)
 {
+	EevoRec a, b;
+	EevoEntry *ents;
 	Eevo ret = eevo_val(EEVO_REC);
 	eevo_arg_num(args, "recmerge", 2);
 	eevo_arg_type(fst(args), "recmerge", EEVO_REC);
 	eevo_arg_type(snd(args), "recmerge", EEVO_REC);
-	ret->v.r = rec_new(snd(args)->v.r->size*EEVO_REC_FACTOR, fst(args)->v.r);
-	for (EevoRec r = snd(args)->v.r; r; r = r->next)
-		for (int i = 0, c = 0; c < r->size; i++)
-			if (r->items[i].key)
-				c++, rec_add(ret->v.r, r->items[i].key, r->items[i].val);
+	a = fst(args)->v.r, b = snd(args)->v.r;
+	if (!a->root) {
+		ret->v.r = a->size + b->size <= EEVO_FRAME_CAP ? rec_new_linear(NULL) : rec_new_trie();
+		ents = rec_entries(a);
+		for (int i = 0; i < a->size; i++)
+			rec_add(ret->v.r, ents[i]->key, ents[i]->val);
+		free(ents);
+		a = ret->v.r;
+	}
+	ents = rec_entries(b);
+	for (int i = 0; i < b->size; i++)
+		if (a == ret->v.r) /* new record is not shared yet */
+			rec_add(a, ents[i]->key, ents[i]->val);
+		else
+			a = rec_assoc(a, ents[i]->key, ents[i]->val);
+	free(ents);
+	if (a == ret->v.r)
+		rec_shape(st, a);
+	ret->v.r = a;
 	return ret;
 }
 
@@ -184,17 +509,16 @@ prim_recmerge(EevoSt st, EevoRec env, Eevo args)
 static Eevo
 prim_records(EevoSt st, EevoRec env, Eevo args)
 {
+	EevoRec r;
+	EevoEntry *ents;
 	Eevo ret = Nil;
 	eevo_arg_num(args, "records", 1);
 	eevo_arg_type(fst(args), "records", EEVO_REC);
-	for (EevoRec r = fst(args)->v.r; r; r = r->next)
-		for (int i = 0, c = 0; c < r->size; i++)
-			if (r->items[i].key) {
-				Eevo entry = eevo_pair(eevo_sym(st, r->items[i].key),
-				                               r->items[i].val);
-				ret = eevo_pair(entry, ret);
-				c++;
-			}
+	r = fst(args)->v.r;
+	ents = rec_entries(r);
+	for (int i = r->size - 1; i >= 0; i--)
+		ret = eevo_pair(eevo_pair(eevo_sym(st, ents[i]->key), ents[i]->val), ret);
+	free(ents);
 	return ret;
 }
 
@@ -212,7 +536,8 @@ form_def(EevoSt st, EevoRec env, Eevo args)
 		if (sym->t != EEVO_SYM)
 			eevo_warnf("def: expected symbol for function name, received '%s'",
 			          eevo_type_str(sym->t));
-		val = eevo_func(EEVO_FUNC, sym->v.s, rfst(args), rst(args), env);
+		val = eevo_func(EEVO_FUNC, sym->v.s, rfst(args), rst(args),
+		                closure_env(st, env, rfst(args), rst(args), sym));
 	} else if (fst(args)->t == EEVO_SYM) { /* create variable */
 		sym = fst(args); /* if only symbol given, make it self evaluating */
 		val = nilp(rst(args)) ? sym : eevo_eval(st, env, snd(args));
@@ -220,26 +545,94 @@ form_def(EevoSt st, EevoRec env, Eevo args)
 	if (!val)
 		return NULL;
 	/* set procedure name if it was previously anonymous */
-	if (val->t & (EEVO_FUNC|EEVO_MACRO) && !val->v.f.name)
+	if (val->t & (EEVO_FUNC|EEVO_MACRO) && (!val->v.f.name || fst(args)->t == EEVO_PAIR)) {
 		val->v.f.name = sym->v.s; /* TODO some bug here */
+		/* closures only captured variables defined before them, add itself for recursion */
+		if (val->v.f.env != env && val->v.f.env != st->env)
+			rec_add(val->v.f.env, sym->v.s, val);
+	}
+	for (; env->loop; env = env->next) ; /* loops only bind their own variable */
 	rec_add(env, sym->v.s, val);
 	return Void;
 }
 
+/* create generic function, which calls the method matching its arguments' types
+ *   defgeneric (name ... args) */
+static Eevo
+form_defgeneric(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo sig;
+	eevo_arg_num(args, "defgeneric", 1);
+	sig = fst(args);
+	if (sig->t != EEVO_PAIR || fst(sig)->t != EEVO_SYM)
+		eevo_warn("defgeneric: expected (name ... args)");
+	for (; env->loop; env = env->next) ;
+	rec_add(env, fst(sig)->v.s, eevo_gen(fst(sig)->v.s, rst(sig)));
+	return Void;
+}
+
+/* add method to generic function, replacing any with the same types
+ *   defmethod (name ... (arg Type)) ... body
+ * arguments without a type match any value */
+static Eevo
+form_defmethod(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo sig, gen, func, params, types, p, t, m, pos, tpos;
+	eevo_arg_min(args, "defmethod", 2);
+	sig = fst(args);
+	if (sig->t != EEVO_PAIR || fst(sig)->t != EEVO_SYM)
+		eevo_warn("defmethod: expected (name ... args)");
+	if (!(gen = rec_get(env, fst(sig)->v.s)) || gen->t != EEVO_GEN)
+		eevo_warnf("defmethod: '%s' is not a generic function", fst(sig)->v.s);
+	if (eevo_lstlen(rst(sig)) != eevo_lstlen(gen->v.g->args))
+		eevo_warnf("defmethod: expected %d arguments for %s, received %d",
+		           eevo_lstlen(gen->v.g->args), fst(sig)->v.s, eevo_lstlen(rst(sig)));
+	params = pos = eevo_pair(NULL, Nil);
+	types = tpos = eevo_pair(NULL, Nil);
+	for (p = rst(sig); p->t == EEVO_PAIR; p = rst(p)) {
+		if (fst(p)->t == EEVO_SYM) {
+			pos = rst(pos) = eevo_pair(fst(p), Nil);
+			tpos = rst(tpos) = eevo_pair(Nil, Nil);
+			continue;
+		}
+		if (fst(p)->t != EEVO_PAIR || ffst(p)->t != EEVO_SYM || eevo_lstlen(fst(p)) != 2)
+			eevo_warn("defmethod: expected argument or (argument Type)");
+		if (eevo_lstlen(rst(types)) >= EEVO_GEN_ARGS)
+			eevo_warnf("defmethod: only first %d arguments can be given types", EEVO_GEN_ARGS);
+		if (!(t = eevo_eval(st, env, snd(fst(p)))))
+			return NULL;
+		eevo_arg_type(t, "defmethod", EEVO_TYPE);
+		pos = rst(pos) = eevo_pair(ffst(p), Nil);
+		tpos = rst(tpos) = eevo_pair(t, Nil);
+	}
+	rst(pos) = p; /* variadic argument */
+	params = rst(params), types = rst(types);
+	func = eevo_func(EEVO_FUNC, fst(sig)->v.s, params, rst(args),
+	                 closure_env(st, env, params, rst(args), fst(sig)));
+	for (m = gen->v.g->methods; m->t == EEVO_PAIR; m = rst(m)) {
+		for (p = ffst(m), t = types; p->t == EEVO_PAIR && t->t == EEVO_PAIR; p = rst(p), t = rst(t))
+			if (fst(p) != fst(t))
+				break;
+		if (nilp(p) && nilp(t))
+			break;
+	}
+	if (m->t == EEVO_PAIR)
+		rst(fst(m)) = func;
+	else
+		gen->v.g->methods = eevo_pair(eevo_pair(types, func), gen->v.g->methods);
+	gen->v.g->version++;
+	return Void;
+}
+
 /* TODO fix crashing if try to undefine builtin */
 static Eevo
 form_undefine(EevoSt st, EevoRec env, Eevo args)
 {
 	eevo_arg_min(args, "undefine!", 1);
 	eevo_arg_type(fst(args), "undefine!", EEVO_SYM);
-	for (EevoRec r = env; r; r = r->next) {
-		EevoEntry e = entry_get(r, fst(args)->v.s);
-		if (e->key) {
-			e->key = NULL;
-			/* TODO eevo_free(e->val); */
+	for (EevoRec r = env; r; r = r->next)
+		if (rec_del(r, fst(args)->v.s)) /* TODO eevo_free(e->val); */
 			return Void;
-		}
-	}
 	eevo_warnf("undefine!: could not find symbol %s to undefine", fst(args)->v.s);
 }
 
@@ -263,13 +656,63 @@ eevo_env_core(EevoSt st)
 {
 	eevo_env_prim(fst);
 	eevo_env_prim(rst);
+	eevo_env_prim(snd);
+	eevo_env_prim(ffst);
+	eevo_env_prim(rfst);
+	eevo_env_prim(rrst);
+	eevo_env_prim(fffst);
+	eevo_env_prim(ffrst);
+	eevo_env_prim(frfst);
+	eevo_env_prim(frrst);
+	eevo_env_prim(rffst);
+	eevo_env_prim(rfrst);
+	eevo_env_prim(rrfst);
+	eevo_env_prim(rrrst);
 	st->types[11]->v.t.func = eevo_prim(EEVO_PRIM, prim_Pair, "Pair");
 	eevo_env_form(quote);
 	eevo_env_prim(eval);
 	eevo_env_name_prim(=, eq);
 	eevo_env_form(cond);
 	eevo_env_add(st, "do", eevo_prim(EEVO_FORM, eevo_eval_body, "do"));
+	eevo_env_form(loop);
+	eevo_env_form(while);
+	eevo_env_form(for);
+	eevo_env_form(break);
+	eevo_env_form(catch);
+	eevo_env_prim(throw);
 
+	eevo_env_name_prim(void?,        voidp);
+	eevo_env_name_prim(nil?,         nilp);
+	eevo_env_name_prim(integer?,     integerp);
+	eevo_env_name_prim(decimal?,     decimalp);
+	eevo_env_name_prim(ratio?,       ratiop);
+	eevo_env_name_prim(rational?,    rationalp);
+	eevo_env_name_prim(number?,      numberp);
+	eevo_env_name_prim(string?,      stringp);
+	eevo_env_name_prim(symbol?,      symbolp);
+	eevo_env_name_prim(primitive?,   primitivep);
+	eevo_env_name_prim(specialform?, specialformp);
+	eevo_env_name_prim(builtin?,     builtinp);
+	eevo_env_name_prim(function?,    functionp);
+	eevo_env_name_prim(macro?,       macrop);
+	eevo_env_name_prim(generic?,     genericp);
+	eevo_env_name_prim(procedure?,   procedurep);
+	eevo_env_name_prim(pair?,        pairp);
+	eevo_env_name_prim(atom?,        atomp);
+	eevo_env_name_prim(record?,      recordp);
+	eevo_env_name_prim(vec?,         vecp);
+	eevo_env_name_prim(pvec?,        pvecp);
+	eevo_env_name_prim(map?,         mapp);
+	eevo_env_name_prim(set?,         setp);
+	eevo_env_name_prim(numarray?,    numarrayp);
+	eevo_env_name_prim(numfunc?,     numfuncp);
+	eevo_env_name_prim(strbuf?,      strbufp);
+	eevo_env_name_prim(rope?,        ropep);
+	eevo_env_name_prim(strview?,     strviewp);
+	eevo_env_name_prim(regex?,       regexp);
+	eevo_env_name_prim(list?,        listp);
+	eevo_env_name_prim(true?,        truep);
+	eevo_env_name_prim(boolean?,     booleanp);
 	eevo_env_prim(typeof);
 	eevo_env_prim(procprops);
 	st->types[9]->v.t.func  = eevo_prim(EEVO_FORM, form_Func,  "Func");
@@ -279,6 +722,8 @@ eevo_env_core(EevoSt st)
 	eevo_env_prim(recmerge);
 	eevo_env_prim(records);
 	eevo_env_form(def);
+	eevo_env_form(defgeneric);
+	eevo_env_form(defmethod);
 	eevo_env_name_form(undefine!, undefine);
 	eevo_env_name_form(defined?, definedp);
 }
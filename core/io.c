@@ -46,6 +46,13 @@ count_parens(char *s, int len)
 	return ccount;
 }
 
+/* return characters of string as NUL terminated C string, views are copied */
+static char *
+io_cstr(Eevo v)
+{
+	return v->t == EEVO_STRVIEW ? str_sub(v->v.sv.s, v->v.sv.len)->v.s : v->v.s;
+}
+
 /* return string containing contents of file name */
 static char *
 read_file(char *fname)
@@ -87,11 +94,11 @@ prim_write(EevoSt st, EevoRec env, Eevo args)
 	/* first argument can either be the symbol stdout or stderr, or the file as a string */
 	if (fst(args)->t == EEVO_SYM)
 		f = !strncmp(fst(args)->v.s, "stdout", 7) ? stdout : stderr;
-	else if (fst(args)->t != EEVO_STR)
+	else if (!(fst(args)->t & (EEVO_STR | EEVO_STRVIEW)))
 		eevo_warnf("write: expected file name as string, received %s",
 		           eevo_type_str(fst(args)->t));
-	else if (!(f = fopen(fst(args)->v.s, mode)))
-		eevo_warnf("write: could not load file '%s'", fst(args)->v.s);
+	else if (!(f = fopen(io_cstr(fst(args)), mode)))
+		eevo_warnf("write: could not load file '%s'", io_cstr(fst(args)));
 	if (f == stderr && strncmp(fst(args)->v.s, "stderr", 7)) /* validate stderr symbol */
 		eevo_warn("write: expected file name as string, or symbol stdout/stderr");
 
@@ -115,8 +122,8 @@ prim_read(EevoSt st, EevoRec env, Eevo args)
 	char *file, *fname = NULL; /* read from stdin by default */
 	eevo_arg_max(args, "read", 1);
 	if (eevo_lstlen(args) == 1) { /* if file name given as string, read it */
-		eevo_arg_type(fst(args), "read", EEVO_STR);
-		fname = fst(args)->v.s;
+		eevo_arg_type(fst(args), "read", EEVO_STR | EEVO_STRVIEW);
+		fname = io_cstr(fst(args));
 	}
 	if (!(file = read_file(fname)))
 		return Nil;
@@ -134,8 +141,8 @@ prim_parse(EevoSt st, EevoRec env, Eevo args)
 	expr = fst(args);
 	if (nilp(expr))
 		return eevo_sym(st, "quit");
-	eevo_arg_type(expr, "parse", EEVO_STR);
-	st->file = expr->v.s;
+	eevo_arg_type(expr, "parse", EEVO_STR | EEVO_STRVIEW);
+	st->file = io_cstr(expr);
 	st->filec = 0;
 	ret = eevo_pair(eevo_sym(st, "do"), Nil);
 	for (Eevo pos = ret; eevo_fget(st) && (expr = eevo_read_line(st, 0)); pos = rst(pos))
@@ -152,6 +159,7 @@ static Eevo
 prim_load(EevoSt st, EevoRec env, Eevo args)
 {
 	Eevo tib;
+	char *tibname;
 	void (*tibenv)(EevoSt);
 	char name[PATH_MAX];
 	const char *paths[] = {
@@ -160,11 +168,12 @@ prim_load(EevoSt st, EevoRec env, Eevo args)
 
 	eevo_arg_num(args, "load", 1);
 	tib = fst(args);
-	eevo_arg_type(tib, "load", EEVO_STR);
+	eevo_arg_type(tib, "load", EEVO_STR | EEVO_STRVIEW);
+	tibname = io_cstr(tib);
 
 	for (int i = 0; paths[i]; i++) {
 		strcpy(name, paths[i]);
-		strcat(name, tib->v.s);
+		strcat(name, tibname);
 		strcat(name, ".evo");
 		if (access(name, R_OK) != -1) {
 			char *file = read_file(name);
@@ -180,18 +189,18 @@ prim_load(EevoSt st, EevoRec env, Eevo args)
 
 	memset(name, 0, sizeof(name));
 	strcpy(name, "libtib");
-	strcat(name, tib->v.s);
+	strcat(name, tibname);
 	strcat(name, ".so");
 	if (!(st->libh[st->libhc] = dlopen(name, RTLD_LAZY)))
-		eevo_warnf("load: could not load '%s':\n; %s", tib->v.s, dlerror());
+		eevo_warnf("load: could not load '%s':\n; %s", tibname, dlerror());
 	dlerror();
 
 	memset(name, 0, sizeof(name));
 	strcpy(name, "eevo_env_");
-	strcat(name, tib->v.s);
+	strcat(name, tibname);
 	tibenv = dlsym(st->libh[st->libhc], name);
 	if (dlerror())
-		eevo_warnf("load: could not run '%s':\n; %s", tib->v.s, dlerror());
+		eevo_warnf("load: could not run '%s':\n; %s", tibname, dlerror());
 	(*tibenv)(st);
 
 	st->libhc++;
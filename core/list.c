@@ -0,0 +1,362 @@
+/* zlib License
+ *
+ * Copyright (c) 2017-2025 Ed van Bruggen
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/* maximum number of nested map and filter calls fused into a single pass */
+#define PIPE_MAX 16
+
+/* step applied to each element of list in a fused pipeline */
+struct pipe {
+	Eevo proc;
+	int filter; /* only keep elements where proc is true, instead of mapping */
+};
+
+static Eevo form_map(EevoSt st, EevoRec env, Eevo args);
+static Eevo form_filter(EevoSt st, EevoRec env, Eevo args);
+
+/* evaluate list expression, fusing any directly nested calls to builtin map or
+ * filter into the pipeline instead of creating their intermediate lists */
+static Eevo
+pipe_source(EevoSt st, EevoRec env, Eevo expr, struct pipe *stages, int *n)
+{
+	Eevo f, proc;
+	while (*n < PIPE_MAX && expr->t == EEVO_PAIR && fst(expr)->t == EEVO_SYM &&
+	       (f = rec_get(env, fst(expr)->v.s)) && f->t == EEVO_FORM &&
+	       (f->v.pr.pr == form_map || f->v.pr.pr == form_filter) &&
+	       eevo_lstlen(rst(expr)) == 2) {
+		if (!(proc = eevo_eval(st, env, snd(expr))))
+			return NULL;
+		stages[(*n)++] = (struct pipe){ proc, f->v.pr.pr == form_filter };
+		expr = fst(rrst(expr));
+	}
+	return eevo_eval(st, env, expr);
+}
+
+/* pass value through each stage of pipeline, starting with innermost
+ * keep is set to 0 if value is removed by a filter */
+static Eevo
+pipe_run(EevoSt st, EevoRec env, struct pipe *stages, int n, Eevo v, int *keep)
+{
+	Eevo r;
+	for (*keep = 1; n--; ) {
+		if (!(r = eval_apply(st, env, stages[n].proc, eevo_pair(v, Nil))))
+			return NULL;
+		if (!stages[n].filter)
+			v = r;
+		else if (nilp(r))
+			return *keep = 0, v;
+	}
+	return v;
+}
+
+/* build new list, or vector if given one, from the elements passing through
+ * the pipeline */
+static Eevo
+pipe_list(EevoSt st, EevoRec env, Eevo args, char *name, int filter)
+{
+	struct pipe stages[PIPE_MAX];
+	Eevo lst, v, ret = eevo_pair(NULL, Nil), pos = ret;
+	int n = 1, keep, filters = filter;
+	eevo_arg_num(args, name, 2);
+	if (!(stages[0].proc = eevo_eval(st, env, fst(args))))
+		return NULL;
+	stages[0].filter = filter;
+	if (!(lst = pipe_source(st, env, snd(args), stages, &n)))
+		return NULL;
+	if (lst->t == EEVO_VEC) {
+		ret = eevo_vec(lst->v.vec.len);
+		for (int i = 0; i < lst->v.vec.len; i++) {
+			if (!(v = pipe_run(st, env, stages, n, lst->v.vec.items[i], &keep)))
+				return NULL;
+			if (keep)
+				vec_push(ret, v);
+		}
+		return ret;
+	}
+	if (lst->t == EEVO_NUMARR) { /* results need to be numbers to be unboxed */
+		int i = 0, c = 0;
+		ret = eevo_numarr(lst->v.na.len);
+		while (seq_next(&lst, &i, &v)) {
+			if (!(v = pipe_run(st, env, stages, n, v, &keep)))
+				return NULL;
+			if (!(v->t & EEVO_NUM))
+				eevo_warnf("%s: expected Num for NumArray, received %s",
+				           name, eevo_type_str(v->t));
+			if (keep)
+				ret->v.na.d[c++] = num(v) / den(v);
+		}
+		ret->v.na.len = c;
+		return ret;
+	}
+	if (lst->t == EEVO_PVEC) { /* new vector is not shared until returned */
+		int i = 0;
+		ret = eevo_pvec();
+		while (seq_next(&lst, &i, &v)) {
+			if (!(v = pipe_run(st, env, stages, n, v, &keep)))
+				return NULL;
+			if (keep)
+				pvec_conj(ret, v, 0);
+		}
+		return ret;
+	}
+	for (; lst->t == EEVO_PAIR; lst = rst(lst)) {
+		if (!(v = pipe_run(st, env, stages, n, fst(lst), &keep)))
+			return NULL;
+		if (keep)
+			pos = rst(pos) = eevo_pair(v, Nil);
+	}
+	for (int i = 1; i < n; i++)
+		filters |= stages[i].filter;
+	/* last element of improper list is mapped, unless filtered */
+	if (!nilp(lst) && !filters && !(rst(pos) = pipe_run(st, env, stages, n, lst, &keep)))
+		return NULL;
+	return rst(ret);
+}
+
+/* return list created by applying procedure to each element of the list */
+static Eevo
+form_map(EevoSt st, EevoRec env, Eevo args)
+{
+	return pipe_list(st, env, args, "map", 0);
+}
+
+/* return list of elements where applying procedure is not nil */
+static Eevo
+form_filter(EevoSt st, EevoRec env, Eevo args)
+{
+	return pipe_list(st, env, args, "filter", 1);
+}
+
+/* combine each element of list with accumulator from left to right */
+static Eevo
+pipe_fold(EevoSt st, EevoRec env, Eevo proc, Eevo acc, Eevo lst,
+          struct pipe *stages, int n)
+{
+	Eevo v;
+	int i = 0, keep;
+	while (seq_next(&lst, &i, &v)) {
+		if (!(v = pipe_run(st, env, stages, n, v, &keep)))
+			return NULL;
+		if (!keep)
+			continue;
+		if (!acc) /* reduce uses first element as initial value */
+			acc = v;
+		else if (!(acc = eval_apply(st, env, proc, eevo_list(st, 2, acc, v))))
+			return NULL;
+	}
+	if (!acc)
+		eevo_warn("reduce: expected non-empty list");
+	return acc;
+}
+
+/* fold list from the left starting with given initial value */
+static Eevo
+form_foldl(EevoSt st, EevoRec env, Eevo args)
+{
+	struct pipe stages[PIPE_MAX];
+	Eevo proc, acc, lst;
+	int n = 0;
+	eevo_arg_num(args, "foldl", 3);
+	if (!(proc = eevo_eval(st, env, fst(args))) || !(acc = eevo_eval(st, env, snd(args))))
+		return NULL;
+	if (!(lst = pipe_source(st, env, fst(rrst(args)), stages, &n)))
+		return NULL;
+	return pipe_fold(st, env, proc, acc, lst, stages, n);
+}
+
+/* fold list from the left using the first element as the initial value */
+static Eevo
+form_reduce(EevoSt st, EevoRec env, Eevo args)
+{
+	struct pipe stages[PIPE_MAX];
+	Eevo proc, lst;
+	int n = 0;
+	eevo_arg_num(args, "reduce", 2);
+	if (!(proc = eevo_eval(st, env, fst(args))))
+		return NULL;
+	if (!(lst = pipe_source(st, env, snd(args), stages, &n)))
+		return NULL;
+	return pipe_fold(st, env, proc, NULL, lst, stages, n);
+}
+
+/* apply procedure to each element of list only for its side effects */
+static Eevo
+form_foreach(EevoSt st, EevoRec env, Eevo args)
+{
+	struct pipe stages[PIPE_MAX];
+	Eevo lst, v;
+	int n = 1, i = 0, keep;
+	eevo_arg_num(args, "for-each", 2);
+	if (!(stages[0].proc = eevo_eval(st, env, fst(args))))
+		return NULL;
+	stages[0].filter = 0;
+	if (!(lst = pipe_source(st, env, snd(args), stages, &n)))
+		return NULL;
+	while (seq_next(&lst, &i, &v))
+		if (!pipe_run(st, env, stages, n, v, &keep))
+			return NULL;
+	return Void;
+}
+
+/* element being sorted and the key it is compared by */
+struct sort_item {
+	Eevo key, val;
+};
+
+/* how elements are compared, numbers and strings are compared directly in C
+ * instead of calling the eevo comparator */
+struct sort {
+	EevoSt st;
+	EevoRec env;
+	Eevo cmp;
+	enum { SORT_CALL, SORT_NUM, SORT_STR } mode;
+	int desc; /* reverse order of builtin comparison */
+};
+
+/* return 1 if key a belongs before b, 0 if not, or -1 on error */
+static int
+sort_lt(struct sort *s, Eevo a, Eevo b)
+{
+	Eevo r;
+	size_t la, lb;
+	int c;
+	if (s->desc) {
+		r = a, a = b, b = r;
+	}
+	switch (s->mode) {
+	case SORT_NUM:
+		return num(a) * den(b) < num(b) * den(a);
+	case SORT_STR: /* any kind of string, shorter first if one starts the other */
+		la = text_len(a), lb = text_len(b);
+		if ((c = memcmp(text_chars(a), text_chars(b), la < lb ? la : lb)))
+			return c < 0;
+		return la < lb;
+	default:
+		if (!(r = eval_apply(s->st, s->env, s->cmp, eevo_list(s->st, 2, a, b))))
+			return -1;
+		return !nilp(r);
+	}
+}
+
+/* stable merge sort of n items, using tmp as scratch space for half of them */
+static int
+sort_merge(struct sort *s, struct sort_item *v, struct sort_item *tmp, int n)
+{
+	int i, j, k, c, m = n / 2;
+	struct sort_item x;
+	if (n <= 8) { /* insertion sort short runs */
+		for (i = 1; i < n; i++) {
+			for (x = v[i], j = i; j > 0; j--) {
+				if ((c = sort_lt(s, x.key, v[j-1].key)) < 0)
+					return -1;
+				if (!c)
+					break;
+				v[j] = v[j-1];
+			}
+			v[j] = x;
+		}
+		return 0;
+	}
+	if (sort_merge(s, v, tmp, m) || sort_merge(s, v + m, tmp, n - m))
+		return -1;
+	if ((c = sort_lt(s, v[m].key, v[m-1].key)) <= 0) /* halves already in order */
+		return c;
+	memcpy(tmp, v, m * sizeof(struct sort_item));
+	for (i = 0, j = m, k = 0; i < m && j < n; k++) {
+		/* only take from second half if strictly less, keeping equal items in order */
+		if ((c = sort_lt(s, v[j].key, tmp[i].key)) < 0)
+			return -1;
+		v[k] = c ? v[j++] : tmp[i++];
+	}
+	memcpy(v + k, tmp + i, (m - i) * sizeof(struct sort_item));
+	return 0;
+}
+
+/* return new sorted list or vector, ordered by optional comparator and key */
+static Eevo
+prim_sort(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo seq, key = Nil, ret, v;
+	struct sort s = { st, env, Nil, SORT_CALL, 0 };
+	struct sort_item *items;
+	EevoType types = 0;
+	int n = 0, i = 0, len = eevo_lstlen(args);
+	if (len < 1 || len > 3)
+		eevo_warnf("sort: expected 1 to 3 arguments, received %d", len);
+	seq = fst(args);
+	eevo_arg_type(seq, "sort", EEVO_LIST | EEVO_VEC | EEVO_PVEC | EEVO_NUMARR);
+	if (len > 1)
+		s.cmp = snd(args);
+	if (len > 2)
+		key = fst(rrst(args));
+	len = seq->t == EEVO_VEC ? seq->v.vec.len : seq->t == EEVO_PVEC ? seq->v.pv.len
+	    : seq->t == EEVO_NUMARR ? seq->v.na.len : abs(eevo_lstlen(seq));
+	if (!(items = malloc((len + len / 2 + 1) * sizeof(struct sort_item))))
+		perror("; malloc"), exit(1);
+	for (ret = seq; seq_next(&ret, &i, &v); n++) {
+		items[n].val = v;
+		if (!nilp(key) && !(v = eval_apply(st, env, key, eevo_pair(v, Nil))))
+			return free(items), NULL;
+		items[n].key = v;
+		types |= v->t;
+	}
+	/* compare directly if using default or builtin < or > on only numbers or strings */
+	if (nilp(s.cmp) || (s.cmp->t == EEVO_PRIM && (!strcmp(s.cmp->v.pr.name, "<") ||
+	                                              !strcmp(s.cmp->v.pr.name, ">")))) {
+		s.desc = !nilp(s.cmp) && s.cmp->v.pr.name[0] == '>';
+		if (!(types & ~EEVO_NUM))
+			s.mode = SORT_NUM;
+		else if (!(types & ~EEVO_STRS))
+			s.mode = SORT_STR;
+		else if (nilp(s.cmp)) {
+			free(items);
+			eevo_warn("sort: expected only numbers or only strings without comparator");
+		}
+	}
+	if (sort_merge(&s, items, items + len, n))
+		return free(items), NULL;
+	if (fst(args)->t == EEVO_VEC) {
+		ret = eevo_vec(n);
+		for (i = 0; i < n; i++)
+			vec_push(ret, items[i].val);
+	} else if (fst(args)->t == EEVO_PVEC) {
+		ret = eevo_pvec();
+		for (i = 0; i < n; i++)
+			pvec_conj(ret, items[i].val, 0);
+	} else if (fst(args)->t == EEVO_NUMARR) {
+		ret = eevo_numarr(n);
+		for (i = 0; i < n; i++)
+			ret->v.na.d[i] = num(items[i].val) / den(items[i].val);
+	} else for (ret = Nil; n--; )
+		ret = eevo_pair(items[n].val, ret);
+	free(items);
+	return ret;
+}
+
+void
+eevo_env_list(EevoSt st)
+{
+	eevo_env_form(map);
+	eevo_env_form(filter);
+	eevo_env_form(foldl);
+	eevo_env_form(reduce);
+	eevo_env_name_form(for-each, foreach);
+	eevo_env_prim(sort);
+}
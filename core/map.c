@@ -0,0 +1,206 @@
+/* zlib License
+ *
+ * Copyright (c) 2017-2025 Ed van Bruggen
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/* create new map from list of alternating keys and values */
+static Eevo
+prim_Map(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret;
+	int len = eevo_lstlen(args);
+	if (len < 0 || len % 2)
+		eevo_warnf("Map: expected even number of arguments, received %d", abs(len));
+	ret = eevo_map(EEVO_MAP, len / 2);
+	for (; args->t == EEVO_PAIR; args = rrst(args))
+		map_put(ret->v.m, fst(args), snd(args));
+	return ret;
+}
+
+/* create new map from list or vector of pairs of keys and values */
+static Eevo
+prim_mapfrom(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret, seq, v;
+	int i = 0;
+	eevo_arg_num(args, "map-from", 1);
+	seq = fst(args);
+	eevo_arg_type(seq, "map-from", EEVO_LIST | EEVO_VEC | EEVO_PVEC);
+	ret = eevo_map(EEVO_MAP, 8);
+	while (seq_next(&seq, &i, &v)) {
+		eevo_arg_type(v, "map-from", EEVO_PAIR);
+		map_put(ret->v.m, fst(v), rst(v));
+	}
+	return ret;
+}
+
+/* return value of key in map, or default (Nil if not given) if not found */
+static Eevo
+prim_mapget(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret;
+	int len = eevo_lstlen(args);
+	if (len != 2 && len != 3)
+		eevo_warnf("map-get: expected 2 or 3 arguments, received %d", len);
+	eevo_arg_type(fst(args), "map-get", EEVO_MAP);
+	if ((ret = map_get(fst(args)->v.m, snd(args))))
+		return ret;
+	return len == 3 ? fst(rrst(args)) : Nil;
+}
+
+/* set value of key in map */
+static Eevo
+prim_mapput(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "map-put!", 3);
+	eevo_arg_type(fst(args), "map-put!", EEVO_MAP);
+	map_put(fst(args)->v.m, snd(args), fst(rrst(args)));
+	return Void;
+}
+
+/* check if map or set contains key */
+static Eevo
+prim_maphas(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "has?", 2);
+	eevo_arg_type(fst(args), "has?", EEVO_MAP | EEVO_SET);
+	return map_get(fst(args)->v.m, snd(args)) ? True : Nil;
+}
+
+/* remove keys from map or set */
+static Eevo
+prim_mapdel(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_min(args, "del!", 1);
+	eevo_arg_type(fst(args), "del!", EEVO_MAP | EEVO_SET);
+	for (Eevo k = rst(args); k->t == EEVO_PAIR; k = rst(k))
+		map_del(fst(args)->v.m, fst(k));
+	return Void;
+}
+
+/* return number of entries in map or set */
+static Eevo
+prim_maplen(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "map-len", 1);
+	eevo_arg_type(fst(args), "map-len", EEVO_MAP | EEVO_SET);
+	return eevo_int(fst(args)->v.m->size);
+}
+
+/* return list of keys of map or values of set, in the order they were added */
+static Eevo
+prim_mapkeys(EevoSt st, EevoRec env, Eevo args)
+{
+	EevoMap m;
+	Eevo ret = Nil;
+	eevo_arg_num(args, "map-keys", 1);
+	eevo_arg_type(fst(args), "map-keys", EEVO_MAP | EEVO_SET);
+	m = fst(args)->v.m;
+	for (int i = m->used - 1; i >= 0; i--)
+		if (m->items[i].key)
+			ret = eevo_pair(m->items[i].key, ret);
+	return ret;
+}
+
+/* return list of values of map, in the order they were added */
+static Eevo
+prim_mapvals(EevoSt st, EevoRec env, Eevo args)
+{
+	EevoMap m;
+	Eevo ret = Nil;
+	eevo_arg_num(args, "map-vals", 1);
+	eevo_arg_type(fst(args), "map-vals", EEVO_MAP);
+	m = fst(args)->v.m;
+	for (int i = m->used - 1; i >= 0; i--)
+		if (m->items[i].key)
+			ret = eevo_pair(m->items[i].val, ret);
+	return ret;
+}
+
+/* return list of pairs of each key and value in map */
+static Eevo
+prim_maplist(EevoSt st, EevoRec env, Eevo args)
+{
+	EevoMap m;
+	Eevo ret = Nil;
+	eevo_arg_num(args, "map-list", 1);
+	eevo_arg_type(fst(args), "map-list", EEVO_MAP);
+	m = fst(args)->v.m;
+	for (int i = m->used - 1; i >= 0; i--)
+		if (m->items[i].key)
+			ret = eevo_pair(eevo_pair(m->items[i].key, m->items[i].val), ret);
+	return ret;
+}
+
+/* create new set from given values */
+static Eevo
+prim_Set(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret = eevo_map(EEVO_SET, abs(eevo_lstlen(args)));
+	for (; args->t == EEVO_PAIR; args = rst(args))
+		map_put(ret->v.m, fst(args), True);
+	return ret;
+}
+
+/* create new set from values in list or vector */
+static Eevo
+prim_setfrom(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret, seq, v;
+	int i = 0;
+	eevo_arg_num(args, "set-from", 1);
+	seq = fst(args);
+	eevo_arg_type(seq, "set-from", EEVO_LIST | EEVO_VEC | EEVO_PVEC);
+	ret = eevo_map(EEVO_SET, 8);
+	while (seq_next(&seq, &i, &v))
+		map_put(ret->v.m, v, True);
+	return ret;
+}
+
+/* add values to set */
+static Eevo
+prim_setadd(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_min(args, "set-add!", 1);
+	eevo_arg_type(fst(args), "set-add!", EEVO_SET);
+	for (Eevo v = rst(args); v->t == EEVO_PAIR; v = rst(v))
+		map_put(fst(args)->v.m, fst(v), True);
+	return Void;
+}
+
+void
+eevo_env_map(EevoSt st)
+{
+	st->types[17]->v.t.func = eevo_prim(EEVO_PRIM, prim_Map, "Map");
+	eevo_env_name_prim(map-from, mapfrom);
+	eevo_env_name_prim(map-get,  mapget);
+	eevo_env_name_prim(map-put!, mapput);
+	eevo_env_name_prim(map-keys, mapkeys);
+	eevo_env_name_prim(map-vals, mapvals);
+	eevo_env_name_prim(map-list, maplist);
+
+	st->types[18]->v.t.func = eevo_prim(EEVO_PRIM, prim_Set, "Set");
+	eevo_env_name_prim(set-from, setfrom);
+	eevo_env_name_prim(set-add!, setadd);
+	eevo_env_name_prim(set-list, mapkeys);
+
+	eevo_env_name_prim(has?,     maphas);
+	eevo_env_name_prim(del!,     mapdel);
+	eevo_env_name_prim(map-len,  maplen);
+}
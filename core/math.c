@@ -66,6 +66,255 @@ static Eevo
 	return &create_int;
 }
 
+static Eevo prim_add(EevoSt st, EevoRec vars, Eevo args);
+static Eevo prim_sub(EevoSt st, EevoRec vars, Eevo args);
+static Eevo prim_mul(EevoSt st, EevoRec vars, Eevo args);
+static Eevo prim_div(EevoSt st, EevoRec vars, Eevo args);
+static Eevo prim_pow(EevoSt st, EevoRec vars, Eevo args);
+
+/* Results which are not exact numbers are kept as expressions like (^ 2 1/2).
+ * These are hash-consed: each node is built from unique subexpressions, so
+ * equal expressions are the same object and large results share structure as
+ * a DAG instead of copying it. Every node is stored with its simplified form,
+ * so each distinct node is only simplified once. */
+
+/* hash of expression node, only looking at the addresses of subexpressions */
+static uint32_t
+expr_hash(Eevo v)
+{
+	uint32_t h = EEVO_PAIR;
+	for (; v->t == EEVO_PAIR; v = rst(v))
+		h = h * 31 + (fst(v)->t == EEVO_PAIR ? (uintptr_t)fst(v) >> 3 : val_hash(fst(v)));
+	return h;
+}
+
+/* test if nodes have the same operator and arguments, subexpressions by identity */
+static int
+expr_eq(Eevo a, Eevo b)
+{
+	for (; a->t == EEVO_PAIR && b->t == EEVO_PAIR; a = rst(a), b = rst(b))
+		if (fst(a)->t != fst(b)->t || (fst(a)->t == EEVO_PAIR ?
+		                               fst(a) != fst(b) : !vals_eq(fst(a), fst(b))))
+			return 0;
+	return a->t == b->t;
+}
+
+/* get slot of expression table for node with hash h, or empty one to be filled */
+static int *
+expr_slot(EevoMap m, Eevo node, uint32_t h)
+{
+	int *p, i = h % m->cap;
+	while (*(p = &m->index[i])) {
+		if (m->items[*p - 1].hash == h && expr_eq(m->items[*p - 1].key, node))
+			break;
+		if (++i == m->cap)
+			i = 0;
+	}
+	return p;
+}
+
+/* add node to expression table at empty slot p, returning its position */
+static int
+expr_add(EevoMap m, int *p, Eevo node, uint32_t h, Eevo val)
+{
+	int i = m->used;
+	m->items[i].key = node;
+	m->items[i].val = val;
+	m->items[i].hash = h;
+	*p = ++m->used;
+	if (++m->size, m->used > m->cap / EEVO_REC_FACTOR)
+		map_resize(m, EEVO_REC_FACTOR * m->size);
+	return i;
+}
+
+/* test if value is the number n */
+static int
+expr_isnum(Eevo v, double n)
+{
+	return v->t & EEVO_NUM && num(v) / den(v) == n;
+}
+
+/* test if value is an expression node with operator op applied to n arguments */
+static int
+expr_isop(Eevo v, char *op, int n)
+{
+	return v->t == EEVO_PAIR && fst(v)->t == EEVO_SYM && !strcmp(fst(v)->v.s, op) &&
+	       eevo_lstlen(v) == n + 1;
+}
+
+/* exact value of functions at x, and function they undo if it holds for any x */
+static const struct { char *op, *inv; int x, fx; } expr_funcs[] = {
+	{ "sin",   "asin",  0, 0 },
+	{ "cos",   "acos",  0, 1 },
+	{ "tan",   "atan",  0, 0 },
+	{ "sinh",  "asinh", 0, 0 },
+	{ "cosh",  "acosh", 0, 1 },
+	{ "tanh",  "atanh", 0, 0 },
+	{ "asin",  NULL,    0, 0 },
+	{ "acos",  NULL,    1, 0 },
+	{ "atan",  NULL,    0, 0 },
+	{ "asinh", "sinh",  0, 0 },
+	{ "acosh", NULL,    1, 0 },
+	{ "atanh", "tanh",  0, 0 },
+	{ "exp",   "log",   0, 1 },
+	{ "log",   "exp",   1, 0 },
+};
+
+/* test if value can be used as expression: a number, symbol, or node of an
+ *   arithmetic operator applied to expressions or function of expr_funcs
+ *   applied to one, nodes already in the table of unique expressions are
+ *   known to be valid without looking at their parts */
+static int
+expr_valid(EevoSt st, Eevo v)
+{
+	int i, len;
+	char *op;
+	if (v->t != EEVO_PAIR)
+		return v->t & (EEVO_NUM | EEVO_SYM);
+	if ((len = eevo_lstlen(v)) < 2 || fst(v)->t != EEVO_SYM)
+		return 0;
+	if (*expr_slot(st->exprs, v, expr_hash(v)))
+		return 1;
+	op = fst(v)->v.s;
+	if (!(strlen(op) == 1 && strchr("+-*/^", *op))) {
+		for (i = 0; i < LEN(expr_funcs) && strcmp(op, expr_funcs[i].op); i++) ;
+		if (i == LEN(expr_funcs) || len != 2)
+			return 0;
+	}
+	for (v = rst(v); v->t == EEVO_PAIR; v = rst(v))
+		if (!expr_valid(st, fst(v)))
+			return 0;
+	return 1;
+}
+#define expr_arg_type(ARG, NAME) do {                                    \
+	if (!expr_valid(st, ARG))                                        \
+		eevo_warnf(NAME ": expected Num, received %s",           \
+		           eevo_type_str(ARG->t));                       \
+} while(0)
+
+/* arithmetic on two values which might be expressions, NULL if either failed */
+static Eevo
+expr_op(EevoSt st, EevoPrim prim, Eevo a, Eevo b)
+{
+	if (!a || !b)
+		return NULL;
+	return prim(st, NULL, eevo_pair(a, eevo_pair(b, Nil)));
+}
+#define EXPR_OP(PRIM, A, B) expr_op(st, PRIM, A, B)
+
+/* return simplified form of node using common identities, numbers are always
+ * moved to the front of sums and products so they can be combined */
+static Eevo
+expr_simplify(EevoSt st, Eevo node)
+{
+	char *op = fst(node)->t == EEVO_SYM ? fst(node)->v.s : "";
+	Eevo a = snd(node), b = rrst(node)->t == EEVO_PAIR ? fst(rrst(node)) : NULL;
+	if (eevo_lstlen(node) == 3) {
+		if (a->t & EEVO_NUM && b->t & EEVO_NUM) { /* only written by hand */
+			if (!strcmp(op, "+")) return EXPR_OP(prim_add, a, b);
+			if (!strcmp(op, "-")) return EXPR_OP(prim_sub, a, b);
+			if (!strcmp(op, "*")) return EXPR_OP(prim_mul, a, b);
+			if (!strcmp(op, "/")) return EXPR_OP(prim_div, a, b);
+			if (!strcmp(op, "^")) return EXPR_OP(prim_pow, a, b);
+		}
+		if (!strcmp(op, "+")) {
+			if (expr_isnum(a, 0)) return b;
+			if (expr_isnum(b, 0)) return a;
+			if (b->t & EEVO_NUM)  return EXPR_OP(prim_add, b, a);
+			if (a == b)           return EXPR_OP(prim_mul, eevo_int(2), a);
+			if (a->t & EEVO_NUM && expr_isop(b, "+", 2) && snd(b)->t & EEVO_NUM)
+				return EXPR_OP(prim_add, EXPR_OP(prim_add, a, snd(b)), fst(rrst(b)));
+		} else if (!strcmp(op, "-")) {
+			if (expr_isnum(b, 0)) return a;
+			if (a == b)           return eevo_int(0);
+			if (expr_isnum(a, 0)) return EXPR_OP(prim_mul, eevo_int(-1), b);
+			if (b->t & EEVO_NUM)  return EXPR_OP(prim_add, EXPR_OP(prim_mul, eevo_int(-1), b), a);
+		} else if (!strcmp(op, "*")) {
+			if (expr_isnum(a, 0) || expr_isnum(b, 1)) return a;
+			if (expr_isnum(b, 0) || expr_isnum(a, 1)) return b;
+			if (b->t & EEVO_NUM)  return EXPR_OP(prim_mul, b, a);
+			if (a == b)           return EXPR_OP(prim_pow, a, eevo_int(2));
+			if (a->t & EEVO_NUM && expr_isop(b, "*", 2) && snd(b)->t & EEVO_NUM)
+				return EXPR_OP(prim_mul, EXPR_OP(prim_mul, a, snd(b)), fst(rrst(b)));
+		} else if (!strcmp(op, "/")) {
+			if (expr_isnum(b, 0)) eevo_warn("division by zero");
+			if (expr_isnum(b, 1) || expr_isnum(a, 0)) return a;
+			if (a == b)           return eevo_int(1);
+			if (b->t & EEVO_NUM)  return EXPR_OP(prim_mul, EXPR_OP(prim_div, eevo_int(1), b), a);
+		} else if (!strcmp(op, "^")) {
+			if (expr_isnum(b, 0) || expr_isnum(a, 1)) return eevo_int(1);
+			if (expr_isnum(b, 1)) return a;
+			/* (x^m)^n = x^(m*n) only holds for integer n */
+			if (b->t == EEVO_INT && expr_isop(a, "^", 2))
+				return EXPR_OP(prim_pow, snd(a), EXPR_OP(prim_mul, fst(rrst(a)), b));
+		}
+	} else if (eevo_lstlen(node) == 2) {
+		for (int i = 0; i < LEN(expr_funcs); i++) {
+			if (strcmp(op, expr_funcs[i].op))
+				continue;
+			if (expr_isnum(a, expr_funcs[i].x))
+				return eevo_int(expr_funcs[i].fx);
+			if (expr_funcs[i].inv && expr_isop(a, expr_funcs[i].inv, 1))
+				return snd(a);
+		}
+	}
+	return node;
+}
+
+/* return unique simplified form of node, whose arguments are already unique */
+static Eevo
+expr_make(EevoSt st, Eevo node)
+{
+	EevoMap m = st->exprs;
+	uint32_t h = expr_hash(node);
+	int i, *p = expr_slot(m, node, h);
+	if (*p && m->items[*p - 1].val)
+		return m->items[*p - 1].val;
+	/* added as its own simplified form first, so simplifying to a number
+	 * which is not exact ends up back at this node instead of looping */
+	if (*p)
+		i = *p - 1, m->items[i].val = node = m->items[i].key;
+	else
+		i = expr_add(m, p, node, h, node);
+	/* entries keep their position, a node which failed to simplify is left
+	 * without a form so it is simplified again to report the error */
+	node = expr_simplify(st, node);
+	return m->items[i].val = node;
+}
+
+/* return unique simplified form of expression, which could have been written
+ * by hand instead of built from unique parts */
+static Eevo
+expr_unique(EevoSt st, Eevo v)
+{
+	Eevo ret = eevo_pair(NULL, Nil), pos = ret, u;
+	int *p;
+	if (v->t != EEVO_PAIR || eevo_lstlen(v) < 0)
+		return v;
+	if (*(p = expr_slot(st->exprs, v, expr_hash(v))) && st->exprs->items[*p - 1].val)
+		return st->exprs->items[*p - 1].val;
+	for (; v->t == EEVO_PAIR; v = rst(v)) {
+		if (!(u = expr_unique(st, fst(v))))
+			return NULL;
+		pos = rst(pos) = eevo_pair(u, Nil);
+	}
+	return expr_make(st, rst(ret));
+}
+
+/* return unique expression of operator applied to one or two arguments */
+static Eevo
+expr_node(EevoSt st, char *op, Eevo a, Eevo b)
+{
+	Eevo args = Nil;
+	if (b && !(b = expr_unique(st, b)))
+		return NULL;
+	if (!(a = expr_unique(st, a)))
+		return NULL;
+	if (b)
+		args = eevo_pair(b, Nil);
+	return expr_make(st, eevo_pair(eevo_sym(st, op), eevo_pair(a, args)));
+}
+
 #define PRIM_ROUND(NAME, FORCE)                                        \
 static Eevo                                                            \
 prim_##NAME(EevoSt st, EevoRec vars, Eevo args)                        \
@@ -94,8 +343,10 @@ prim_add(EevoSt st, EevoRec vars, Eevo args)
 	Eevo a, b;
 	eevo_arg_num(args, "+", 2);
 	a = fst(args), b = snd(args);
-	eevo_arg_type(a, "+", EEVO_NUM);
-	eevo_arg_type(b, "+", EEVO_NUM);
+	expr_arg_type(a, "+");
+	expr_arg_type(b, "+");
+	if (!(a->t & EEVO_NUM && b->t & EEVO_NUM))
+		return expr_node(st, "+", a, b);
 	if (a->t & EEVO_DEC || b->t & EEVO_DEC)
 		return eevo_dec((num(a)/den(a)) + (num(b)/den(b)));
 	return (eevo_num(a->t, b->t, 0))
@@ -111,14 +362,16 @@ prim_sub(EevoSt st, EevoRec vars, Eevo args)
 	if (len != 2 && len != 1)
 		eevo_warnf("-: expected 1 or 2 arguments, recieved %d", len);
 	a = fst(args);
-	eevo_arg_type(a, "-", EEVO_NUM);
+	expr_arg_type(a, "-");
 	if (len == 1) {
 		b = a;
 		a = eevo_int(0);
 	} else {
 		b = snd(args);
-		eevo_arg_type(b, "-", EEVO_NUM);
+		expr_arg_type(b, "-");
 	}
+	if (!(a->t & EEVO_NUM && b->t & EEVO_NUM))
+		return expr_node(st, "-", a, b);
 	if (a->t & EEVO_DEC || b->t & EEVO_DEC)
 		return eevo_dec((num(a)/den(a)) - (num(b)/den(b)));
 	return (eevo_num(a->t, b->t, 0))
@@ -132,8 +385,10 @@ prim_mul(EevoSt st, EevoRec vars, Eevo args)
 	Eevo a, b;
 	eevo_arg_num(args, "*", 2);
 	a = fst(args), b = snd(args);
-	eevo_arg_type(a, "*", EEVO_NUM);
-	eevo_arg_type(b, "*", EEVO_NUM);
+	expr_arg_type(a, "*");
+	expr_arg_type(b, "*");
+	if (!(a->t & EEVO_NUM && b->t & EEVO_NUM))
+		return expr_node(st, "*", a, b);
 	if (a->t & EEVO_DEC || b->t & EEVO_DEC)
 		return eevo_dec((num(a)/den(a)) * (num(b)/den(b)));
 	return (eevo_num(a->t, b->t, 0))(num(a) * num(b), den(a) * den(b));
@@ -148,14 +403,16 @@ prim_div(EevoSt st, EevoRec vars, Eevo args)
 	if (len != 2 && len != 1)
 		eevo_warnf("/: expected 1 or 2 arguments, recieved %d", len);
 	a = fst(args);
-	eevo_arg_type(a, "/", EEVO_NUM);
+	expr_arg_type(a, "/");
 	if (len == 1) {
 		b = a;
 		a = eevo_int(1);
 	} else {
 		b = snd(args);
-		eevo_arg_type(b, "/", EEVO_NUM);
+		expr_arg_type(b, "/");
 	}
+	if (!(a->t & EEVO_NUM && b->t & EEVO_NUM))
+		return expr_node(st, "/", a, b);
 	if (a->t & EEVO_DEC || b->t & EEVO_DEC)
 		return eevo_dec((num(a)/den(a)) / (num(b)/den(b)));
 	return (eevo_num(a->t, b->t, 1))(num(a) * den(b), den(a) * num(b));
@@ -182,14 +439,16 @@ prim_pow(EevoSt st, EevoRec vars, Eevo args)
 	double bnum, bden;
 	eevo_arg_num(args, "pow", 2);
 	b = fst(args), p = snd(args);
-	eevo_arg_type(b, "pow", EEVO_EXPR);
-	eevo_arg_type(p, "pow", EEVO_EXPR);
+	expr_arg_type(b, "pow");
+	expr_arg_type(p, "pow");
+	if (!(b->t & EEVO_NUM && p->t & EEVO_NUM))
+		return expr_node(st, "^", b, p);
 	bnum = pow(num(b), num(p)/den(p));
 	bden = pow(den(b), num(p)/den(p));
 	if ((bnum == (int)bnum && bden == (int)bden) ||
 	     b->t & EEVO_DEC || p->t & EEVO_DEC)
 		return eevo_num(b->t, p->t, 0)(bnum, bden);
-	return eevo_list(st, 3, eevo_sym(st, "^"), b, p);
+	return expr_node(st, "^", b, p);
 }
 
 #define PRIM_COMPARE(NAME, OP)                      \
@@ -215,10 +474,10 @@ static Eevo                                                      \
 prim_##NAME(EevoSt st, EevoRec vars, Eevo args)                  \
 {                                                                \
 	eevo_arg_num(args, #NAME, 1);                            \
-	eevo_arg_type(fst(args), #NAME, EEVO_EXPR);              \
+	expr_arg_type(fst(args), #NAME);                         \
 	if (fst(args)->t & EEVO_DEC)                             \
 		return eevo_dec(NAME(num(fst(args))));           \
-	return eevo_list(st, 2, eevo_sym(st, #NAME), fst(args)); \
+	return expr_node(st, #NAME, fst(args), NULL);            \
 }
 
 PRIM_TRIG(sin)
@@ -236,6 +495,180 @@ PRIM_TRIG(atanh)
 PRIM_TRIG(exp)
 PRIM_TRIG(log)
 
+/* Expressions are compiled to number functions, which run as a flat list of
+ * instructions on decimals instead of walking the expression each time. Since
+ * expressions are made unique first, repeated parts are only computed once. */
+
+/* math functions which can be compiled, by name used in expressions */
+static const struct { char *name; double (*f)(double); } numfn_funcs[] = {
+	{ "sin",   sin   }, { "cos",   cos   }, { "tan",   tan   },
+	{ "sinh",  sinh  }, { "cosh",  cosh  }, { "tanh",  tanh  },
+	{ "asin",  asin  }, { "acos",  acos  }, { "atan",  atan  },
+	{ "asinh", asinh }, { "acosh", acosh }, { "atanh", atanh },
+	{ "arcsin",  asin  }, { "arccos",  acos  }, { "arctan",  atan  },
+	{ "arcsinh", asinh }, { "arccosh", acosh }, { "arctanh", atanh },
+	{ "exp",   exp   }, { "log",   log   }, { "sqrt",  sqrt  }, { "abs", fabs },
+};
+
+/* arithmetic operators which can be compiled */
+static const struct { char *name; int op; } numfn_ops[] = {
+	{ "+", NUMOP_ADD }, { "-", NUMOP_SUB }, { "*", NUMOP_MUL },
+	{ "/", NUMOP_DIV }, { "^", NUMOP_POW },
+};
+
+/* return new register set to x, growing registers when full */
+static int
+numfn_reg(EevoNumFn nf, double x)
+{
+	if (!(nf->regc & (nf->regc - 1)) && /* capacity doubles at each power of 2 */
+	    !(nf->regs = realloc(nf->regs, (2 * nf->regc + 1) * sizeof(double))))
+		perror("; realloc"), exit(1);
+	nf->regs[nf->regc] = x;
+	return nf->regc++;
+}
+
+/* add instruction to program, returning register of its result */
+static int
+numfn_emit(EevoNumFn nf, int op, int a, int b, double (*f)(double))
+{
+	if (!(nf->len & (nf->len - 1)) &&
+	    !(nf->code = realloc(nf->code, (2 * nf->len + 1) * sizeof(struct EevoNumOp_))))
+		perror("; realloc"), exit(1);
+	nf->code[nf->len].op = op;
+	nf->code[nf->len].r = numfn_reg(nf, 0);
+	nf->code[nf->len].a = a;
+	nf->code[nf->len].b = b;
+	nf->code[nf->len].f = f;
+	return nf->code[nf->len++].r;
+}
+
+/* compile expression v, setting reg to register holding its result, nodes
+ * already compiled are found in seen */
+static Eevo
+numfn_compile(EevoSt st, EevoNumFn nf, EevoMap seen, Eevo v, int *reg)
+{
+	int i, r, op = -1, *p;
+	uint32_t h;
+	Eevo a;
+	if (v->t & EEVO_NUM) {
+		*reg = numfn_reg(nf, num(v) / den(v));
+		return True;
+	}
+	if (v->t == EEVO_SYM) {
+		for (i = 0, a = nf->args; a->t == EEVO_PAIR; a = rst(a), i++)
+			if (fst(a) == v)
+				return *reg = i, True;
+		eevo_warnf("lambdify: unknown variable '%s'", v->v.s);
+	}
+	if (v->t != EEVO_PAIR || fst(v)->t != EEVO_SYM || eevo_lstlen(v) < 2)
+		eevo_warnf("lambdify: expected expression, received %s", eevo_print(v));
+	if (*(p = expr_slot(seen, v, h = expr_hash(v))))
+		return *reg = num(seen->items[*p - 1].val), True;
+	for (i = 0; i < LEN(numfn_ops); i++)
+		if (!strcmp(fst(v)->v.s, numfn_ops[i].name))
+			op = numfn_ops[i].op;
+	if (op >= 0) { /* operators combine each argument from left to right */
+		if (!numfn_compile(st, nf, seen, snd(v), reg))
+			return NULL;
+		if (nilp(rrst(v)) && op == NUMOP_SUB) /* negate */
+			*reg = numfn_emit(nf, op, numfn_reg(nf, 0), *reg, NULL);
+		else if (nilp(rrst(v)) && op == NUMOP_DIV) /* reciprocal */
+			*reg = numfn_emit(nf, op, numfn_reg(nf, 1), *reg, NULL);
+		for (a = rrst(v); a->t == EEVO_PAIR; a = rst(a)) {
+			if (!numfn_compile(st, nf, seen, fst(a), &r))
+				return NULL;
+			*reg = numfn_emit(nf, op, *reg, r, NULL);
+		}
+	} else {
+		for (i = 0; i < LEN(numfn_funcs) && strcmp(fst(v)->v.s, numfn_funcs[i].name); i++) ;
+		if (i == LEN(numfn_funcs))
+			eevo_warnf("lambdify: unknown function '%s'", fst(v)->v.s);
+		eevo_arg_num(rst(v), numfn_funcs[i].name, 1);
+		if (!numfn_compile(st, nf, seen, snd(v), &r))
+			return NULL;
+		*reg = numfn_emit(nf, NUMOP_CALL, r, 0, numfn_funcs[i].f);
+	}
+	expr_add(seen, p, v, h, eevo_int(*reg));
+	return True;
+}
+
+/* run program of number function on arguments already in registers */
+static double
+numfn_run(EevoNumFn nf)
+{
+	double *r = nf->regs;
+	for (struct EevoNumOp_ *c = nf->code, *end = c + nf->len; c < end; c++)
+		switch (c->op) {
+		case NUMOP_ADD:  r[c->r] = r[c->a] + r[c->b]; break;
+		case NUMOP_SUB:  r[c->r] = r[c->a] - r[c->b]; break;
+		case NUMOP_MUL:  r[c->r] = r[c->a] * r[c->b]; break;
+		case NUMOP_DIV:  r[c->r] = r[c->a] / r[c->b]; break;
+		case NUMOP_POW:  r[c->r] = pow(r[c->a], r[c->b]); break;
+		case NUMOP_CALL: r[c->r] = c->f(r[c->a]); break;
+		}
+	return r[nf->ret];
+}
+
+/* call number function on numbers, or on each element of number arrays with
+ * numbers used for every element */
+static Eevo
+numfn_call(Eevo f, Eevo args)
+{
+	EevoNumFn nf = f->v.nf;
+	Eevo a, ret;
+	int i, j, len = -1;
+	eevo_arg_num(args, "NumFunc", nf->argc);
+	for (i = 0, a = args; a->t == EEVO_PAIR; a = rst(a), i++) {
+		eevo_arg_type(fst(a), "NumFunc", EEVO_NUM | EEVO_NUMARR);
+		if (fst(a)->t & EEVO_NUM)
+			nf->regs[i] = num(fst(a)) / den(fst(a));
+		else if (len >= 0 && len != fst(a)->v.na.len)
+			eevo_warnf("NumFunc: expected arrays of same length, received %d and %d",
+			           len, fst(a)->v.na.len);
+		else
+			len = fst(a)->v.na.len;
+	}
+	if (len < 0)
+		return eevo_dec(numfn_run(nf));
+	ret = eevo_numarr(len);
+	for (j = 0; j < len; j++) {
+		for (i = 0, a = args; a->t == EEVO_PAIR; a = rst(a), i++)
+			if (fst(a)->t == EEVO_NUMARR)
+				nf->regs[i] = fst(a)->v.na.d[j];
+		ret->v.na.d[j] = numfn_run(nf);
+	}
+	return ret;
+}
+
+/* compile expression into number function of given variables */
+static Eevo
+prim_lambdify(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret, expr;
+	eevo_arg_num(args, "lambdify", 2);
+	eevo_arg_type(fst(args), "lambdify", EEVO_LIST);
+	for (Eevo a = fst(args); a->t == EEVO_PAIR; a = rst(a))
+		eevo_arg_type(fst(a), "lambdify", EEVO_SYM);
+	expr_arg_type(snd(args), "lambdify");
+	if (!(expr = expr_unique(st, snd(args))))
+		return NULL;
+	ret = eevo_numfn(fst(args), expr);
+	for (int i = 0; i < ret->v.nf->argc; i++)
+		numfn_reg(ret->v.nf, 0);
+	if (!numfn_compile(st, ret->v.nf, eevo_map(EEVO_MAP, 16)->v.m, expr, &ret->v.nf->ret))
+		return NULL;
+	return ret;
+}
+
+/* return unique simplified form of expression */
+static Eevo
+prim_simplify(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "simplify", 1);
+	expr_arg_type(fst(args), "simplify");
+	return expr_unique(st, fst(args));
+}
+
 static Eevo
 prim_numerator(EevoSt st, EevoRec env, Eevo args)
 {
@@ -257,6 +690,8 @@ eevo_env_math(EevoSt st)
 {
 	st->types[2]->v.t.func = eevo_prim(EEVO_PRIM, prim_Int, "Int");
 	st->types[3]->v.t.func = eevo_prim(EEVO_PRIM, prim_Dec, "Dec");
+	st->types[20]->v.t.func = eevo_prim(EEVO_PRIM, prim_lambdify, "NumFunc");
+	st->exprs = eevo_map(EEVO_MAP, 64)->v.m;
 	eevo_env_prim(floor);
 	eevo_env_prim(ceil);
 	eevo_env_prim(round);
@@ -289,4 +724,6 @@ eevo_env_math(EevoSt st)
 	eevo_env_name_prim(arctanh, atanh);
 	eevo_env_prim(exp);
 	eevo_env_prim(log);
+	eevo_env_prim(simplify);
+	eevo_env_prim(lambdify);
 }
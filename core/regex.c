@@ -0,0 +1,996 @@
+/* zlib License
+ *
+ * Copyright (c) 2017-2025 Ed van Bruggen
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/* Regular expressions are parsed into a tree of nodes, which is compiled into
+ * a program for a Thompson NFA. Whole matches and searches run a DFA whose
+ * states are the ordered lists of NFA threads alive after each character.
+ * States are only built the first time a transition is taken, and are cached
+ * in the regex so later matches reuse them, making matching linear in the
+ * length of the text. Searching runs the DFA forwards to find where the
+ * leftmost match ends, then runs a DFA for the reversed pattern backwards from
+ * there to find where it starts. Capture groups are found by running the NFA
+ * program as a Pike VM over just the text of the match.
+ *
+ * Syntax: literal characters, . [abc] [^a-z] \d \w \s \D \W \S, escapes with
+ * \, ^ and $ for the start and end of the text, groups (...) and (?:...),
+ * alternation |, and the quantifiers * + ? {n} {n,} {n,m}, which are lazy
+ * when followed by ? Characters above ASCII are compiled to sequences of byte
+ * sets of their UTF-8, so the machines still only read bytes */
+
+#define RE_MAXPROG   30000 /* instructions in a compiled program */
+#define RE_MAXREP    1000  /* count given to {n,m} */
+#define RE_MAXSTATES 1024  /* DFA states cached before starting over */
+#define RE_BUCKETS   1024
+
+#define RE_HAS(CLS, C) ((CLS)[(C) >> 5] >> ((C) & 31) & 1)
+
+/* node of parsed pattern */
+typedef struct {
+	enum { RN_CLASS, RN_CAT, RN_ALT, RN_REP, RN_GROUP, RN_BOL, RN_EOL, RN_EMPTY } t;
+	int a, b;          /* child nodes, or byte set of RN_CLASS */
+	int min, max, lazy; /* repetition count, max is -1 if unbounded, or group number */
+} ReNode;
+
+typedef struct {
+	char *s, *err;
+	ReNode *nodes;
+	struct EevoReInst_ *prog; /* program being compiled */
+	int len;
+	int nodec, nodecap, ngroup;
+	EevoRegex re;
+	int clsc, clscap;
+} ReParse;
+
+/* set of characters being parsed, ASCII as bits and others as code point ranges */
+typedef struct {
+	uint32_t ascii[8];
+	int (*r)[2], n, cap;
+} ReSet;
+
+/* DFA state, the threads are positions in the program waiting on a character,
+ * the end of the text, or a match, in order of priority */
+typedef struct ReState_ *ReState;
+struct ReState_ {
+	ReState next[256]; /* state after each byte, NULL until first needed */
+	ReState chain;     /* next state in the same bucket of the cache */
+	uint32_t hash;
+	int flags, match, endmatch; /* endmatch is -1 until known */
+	int n, pcs[];
+};
+
+enum { RE_FULL, RE_SEARCH, RE_REVERSE }; /* DFA modes, see re_dfa_end and re_dfa_start */
+enum { RE_BEGIN = 1, RE_SEARCHING = 2 }; /* at start of text, still adding new starts */
+
+struct EevoReDfa_ {
+	ReState buckets[RE_BUCKETS];
+	struct EevoReInst_ *prog;
+	ReState start[2]; /* start state away from or at start of text */
+	int mode, len, flushes;
+};
+
+/* space for the threads followed by each step */
+struct EevoReWork_ {
+	int *mark, gen, matched;
+	int *stack, *list;
+	struct { int pc, *caps; } *clist, *nlist;
+	int *caps;
+	int *groups; /* captures of last match found */
+};
+
+/* parsing */
+
+static int
+re_node(ReParse *p, int t, int a, int b)
+{
+	if (p->nodec == p->nodecap &&
+	    !(p->nodes = realloc(p->nodes, (p->nodecap = 2 * p->nodecap + 16) * sizeof(ReNode))))
+		perror("; realloc"), exit(1);
+	p->nodes[p->nodec] = (ReNode){ t, a, b, 0, 0, 0 };
+	return p->nodec++;
+}
+
+/* return new empty byte set */
+static int
+re_cls(ReParse *p)
+{
+	EevoRegex re = p->re;
+	if (p->clsc == p->clscap &&
+	    !(re->cls = realloc(re->cls, (p->clscap = 2 * p->clscap + 8) * sizeof(*re->cls))))
+		perror("; realloc"), exit(1);
+	memset(re->cls[p->clsc], 0, sizeof(*re->cls));
+	return p->clsc++;
+}
+
+static void
+re_cls_range(uint32_t *cls, int from, int to)
+{
+	for (int c = from; c <= to; c++)
+		cls[c >> 5] |= 1u << (c & 31);
+}
+
+/* add code points from through to to set, ASCII as bytes and the rest as ranges */
+static void
+re_set_add(ReSet *set, int from, int to)
+{
+	if (from < 0x80)
+		re_cls_range(set->ascii, from, to < 0x80 ? to : 0x7F), from = 0x80;
+	if (from > to)
+		return;
+	if (set->n == set->cap &&
+	    !(set->r = realloc(set->r, (set->cap = 2 * set->cap + 8) * sizeof(*set->r))))
+		perror("; realloc"), exit(1);
+	set->r[set->n][0] = from, set->r[set->n++][1] = to;
+}
+
+/* add characters of escape \d \w \s or their inverse to set, returns 0 if c isn't one */
+static int
+re_set_escape(ReSet *set, int c)
+{
+	uint32_t tmp[8] = { 0 };
+	switch (tolower(c)) {
+	case 'd': re_cls_range(tmp, '0', '9'); break;
+	case 'w': re_cls_range(tmp, '0', '9'), re_cls_range(tmp, 'a', 'z');
+	          re_cls_range(tmp, 'A', 'Z'), re_cls_range(tmp, '_', '_'); break;
+	case 's': re_cls_range(tmp, '\t', '\r'), re_cls_range(tmp, ' ', ' '); break;
+	default: return 0;
+	}
+	for (int i = 0; i < 4; i++) /* only ASCII, others are added as a range */
+		set->ascii[i] |= isupper(c) ? ~tmp[i] : tmp[i];
+	if (isupper(c))
+		re_set_add(set, 0x80, 0x10FFFF);
+	return 1;
+}
+
+/* character given after backslash, or -1 for letters and digits which don't
+ * have a meaning, so they can be given one later without changing patterns */
+static int
+re_escape_char(int c)
+{
+	switch (c) {
+	case 'n': return '\n';
+	case 't': return '\t';
+	case 'r': return '\r';
+	case 'f': return '\f';
+	case 'v': return '\v';
+	case '0': return '\0';
+	default:  return c < 0x80 && isalnum(c) ? -1 : c;
+	}
+}
+
+/* return code point at start of pattern and move past it, pattern is valid UTF-8 */
+static int
+re_char(ReParse *p)
+{
+	int len = utf8_size(p->s, strlen(p->s));
+	int c = utf8_decode(p->s, len);
+	p->s += len;
+	return c;
+}
+
+/* return node matching either a or b, where -1 is a node matching nothing */
+static int
+re_alt(ReParse *p, int a, int b)
+{
+	return a < 0 ? b : b < 0 ? a : re_node(p, RN_ALT, a, b);
+}
+
+/* return node matching one byte from through to */
+static int
+re_byte(ReParse *p, int from, int to)
+{
+	int cls = re_cls(p);
+	re_cls_range(p->re->cls[cls], from, to);
+	return re_node(p, RN_CLASS, cls, 0);
+}
+
+/* return node matching UTF-8 of any code point from lo through hi, split into
+ * ranges whose characters have the same length and only differ in a run of
+ * trailing bytes, so each is a sequence of byte ranges */
+static int
+re_utf8_range(ReParse *p, int lo, int hi)
+{
+	static const int last[] = { 0x7F, 0x7FF, 0xFFFF };
+	static const int lead[][2] = { { 0xC2, 0xDF }, { 0xE0, 0xEF }, { 0xF0, 0xF4 } };
+	char a[4], b[4];
+	int i, m, n, ret = -1;
+	if (lo > hi)
+		return -1;
+	if (lo == 0x80 && hi == 0x10FFFF) { /* any, text is valid so only check lengths */
+		for (i = 0; i < LEN(lead); i++) {
+			m = re_byte(p, lead[i][0], lead[i][1]);
+			for (n = 0; n <= i; n++)
+				m = re_node(p, RN_CAT, m, re_byte(p, 0x80, 0xBF));
+			ret = re_alt(p, ret, m);
+		}
+		return ret;
+	}
+	for (i = 0; i < LEN(last); i++) /* split where characters get longer */
+		if (lo <= last[i] && hi > last[i])
+			return re_alt(p, re_utf8_range(p, lo, last[i]), re_utf8_range(p, last[i] + 1, hi));
+	if (lo <= 0xDFFF && hi >= 0xD800) /* surrogates aren't characters */
+		return re_alt(p, re_utf8_range(p, lo, 0xD7FF), re_utf8_range(p, 0xE000, hi));
+	for (i = 1; i < 4; i++) {
+		m = (1 << 6 * i) - 1;
+		if ((lo & ~m) == (hi & ~m))
+			continue;
+		if (lo & m)
+			return re_alt(p, re_utf8_range(p, lo, lo | m), re_utf8_range(p, (lo | m) + 1, hi));
+		if ((hi & m) != m)
+			return re_alt(p, re_utf8_range(p, lo, (hi & ~m) - 1), re_utf8_range(p, hi & ~m, hi));
+	}
+	n = utf8_encode(a, lo), utf8_encode(b, hi);
+	for (i = 0; i < n; i++) {
+		m = re_byte(p, (unsigned char)a[i], (unsigned char)b[i]);
+		ret = ret < 0 ? m : re_node(p, RN_CAT, ret, m);
+	}
+	return ret;
+}
+
+static int
+re_range_cmp(const void *a, const void *b)
+{
+	return *(const int *)a - *(const int *)b;
+}
+
+/* return node matching one character of set, or any character not in it if neg
+ * is set, then free the set. Characters above ASCII are matched as sequences
+ * of bytes, so quantifiers apply to the whole character */
+static int
+re_set_node(ReParse *p, ReSet *set, int neg)
+{
+	int i, from, to, lo = 0x80, n = set->n, ret = -1;
+	if (neg) { /* replace ranges by the gaps between them, in place */
+		if (n)
+			qsort(set->r, n, sizeof(*set->r), re_range_cmp);
+		for (i = 0, set->n = 0; i < n; i++) {
+			from = set->r[i][0], to = set->r[i][1];
+			if (from > lo)
+				re_set_add(set, lo, from - 1);
+			if (to >= lo)
+				lo = to + 1;
+		}
+		re_set_add(set, lo, 0x10FFFF);
+		for (i = 0; i < 4; i++)
+			set->ascii[i] = ~set->ascii[i];
+	}
+	if (set->ascii[0] | set->ascii[1] | set->ascii[2] | set->ascii[3] || !set->n) {
+		ret = re_node(p, RN_CLASS, re_cls(p), 0);
+		memcpy(p->re->cls[p->nodes[ret].a], set->ascii, sizeof(set->ascii));
+	}
+	for (i = 0; i < set->n; i++)
+		ret = re_alt(p, ret, re_utf8_range(p, set->r[i][0], set->r[i][1]));
+	free(set->r);
+	return ret;
+}
+
+/* read character of set or after backslash, adding escapes like \d to set,
+ * returns character, -2 if it was such an escape, or -1 on error */
+static int
+re_set_char(ReParse *p, ReSet *set)
+{
+	int c;
+	if (*p->s != '\\')
+		return re_char(p);
+	if (!*++p->s) {
+		p->err = "trailing backslash";
+		return -1;
+	}
+	if (set && re_set_escape(set, (unsigned char)*p->s))
+		return p->s++, -2;
+	if ((unsigned char)*p->s >= 0x80)
+		return re_char(p);
+	if ((c = re_escape_char((unsigned char)*p->s++)) < 0)
+		p->err = "unknown escape";
+	return c;
+}
+
+/* parse [...] set of characters, starting after the opening bracket */
+static int
+re_parse_class(ReParse *p)
+{
+	ReSet set = { { 0 }, NULL, 0, 0 };
+	int neg = 0, c, to;
+	if (*p->s == '^')
+		neg = 1, p->s++;
+	for (int first = 1; *p->s != ']' || first; first = 0) {
+		if (!*p->s)
+			p->err = "missing ] to close character set";
+		else if ((c = re_set_char(p, &set)) == -2)
+			continue;
+		to = c;
+		if (!p->err && p->s[0] == '-' && p->s[1] && p->s[1] != ']') {
+			p->s++;
+			if ((to = re_set_char(p, NULL)) >= 0 && to < c)
+				p->err = "character range out of order";
+		}
+		if (p->err)
+			return free(set.r), -1;
+		re_set_add(&set, c, to);
+	}
+	p->s++;
+	return re_set_node(p, &set, neg);
+}
+
+static int re_parse_alt(ReParse *p);
+
+/* parse single character, set, group or anchor */
+static int
+re_parse_atom(ReParse *p)
+{
+	ReSet set = { { 0 }, NULL, 0, 0 };
+	int n, c;
+	switch (*p->s) {
+	case '(':
+		if (p->s[1] == '?' && p->s[2] == ':') {
+			p->s += 3;
+			n = -1;
+		} else {
+			p->s++;
+			n = ++p->ngroup;
+		}
+		if ((c = re_parse_alt(p)) < 0)
+			return -1;
+		if (*p->s != ')') {
+			p->err = "missing ) to close group";
+			return -1;
+		}
+		p->s++;
+		if (n < 0)
+			return c;
+		c = re_node(p, RN_GROUP, c, 0);
+		p->nodes[c].min = n;
+		return c;
+	case '[':
+		p->s++;
+		return re_parse_class(p);
+	case '^': p->s++; return re_node(p, RN_BOL, 0, 0);
+	case '$': p->s++; return re_node(p, RN_EOL, 0, 0);
+	case '*': case '+': case '?':
+		p->err = "nothing to repeat";
+		return -1;
+	case '.': /* any character except newline */
+		p->s++;
+		re_set_add(&set, 0, '\n' - 1);
+		re_set_add(&set, '\n' + 1, 0x10FFFF);
+		return re_set_node(p, &set, 0);
+	}
+	if ((c = re_set_char(p, &set)) == -1)
+		return -1;
+	if (c >= 0)
+		re_set_add(&set, c, c);
+	return re_set_node(p, &set, 0);
+}
+
+/* parse number for {n,m}, returns -1 if there isn't one */
+static int
+re_parse_count(ReParse *p)
+{
+	int n = 0;
+	if (!isdigit((unsigned char)*p->s))
+		return -1;
+	for (; isdigit((unsigned char)*p->s); p->s++)
+		if (n <= RE_MAXREP) /* too large either way, avoid overflow */
+			n = n * 10 + *p->s - '0';
+	return n;
+}
+
+/* parse atom followed by any quantifiers */
+static int
+re_parse_rep(ReParse *p)
+{
+	int n, min, max;
+	if ((n = re_parse_atom(p)) < 0)
+		return -1;
+	for (;;) {
+		char *s = p->s;
+		switch (*p->s) {
+		case '*': min = 0, max = -1, p->s++; break;
+		case '+': min = 1, max = -1, p->s++; break;
+		case '?': min = 0, max = 1,  p->s++; break;
+		case '{':
+			p->s++;
+			if ((min = max = re_parse_count(p)) < 0) { /* not a count, { is literal */
+				p->s = s;
+				return n;
+			}
+			if (*p->s == ',') {
+				p->s++;
+				if ((max = re_parse_count(p)) >= 0 && max < min) {
+					p->err = "repetition range out of order";
+					return -1;
+				}
+			}
+			if (*p->s != '}') {
+				p->s = s;
+				return n;
+			}
+			p->s++;
+			if (min > RE_MAXREP || max > RE_MAXREP) {
+				p->err = "repetition count too large";
+				return -1;
+			}
+			break;
+		default:
+			return n;
+		}
+		n = re_node(p, RN_REP, n, 0);
+		p->nodes[n].min = min, p->nodes[n].max = max;
+		if (*p->s == '?')
+			p->nodes[n].lazy = 1, p->s++;
+	}
+}
+
+/* parse sequence of repeated atoms */
+static int
+re_parse_cat(ReParse *p)
+{
+	int n = -1, r;
+	while (*p->s && *p->s != '|' && *p->s != ')') {
+		if ((r = re_parse_rep(p)) < 0)
+			return -1;
+		n = n < 0 ? r : re_node(p, RN_CAT, n, r);
+	}
+	return n < 0 ? re_node(p, RN_EMPTY, 0, 0) : n;
+}
+
+/* parse alternatives separated by | */
+static int
+re_parse_alt(ReParse *p)
+{
+	int n, r;
+	if ((n = re_parse_cat(p)) < 0)
+		return -1;
+	while (*p->s == '|') {
+		p->s++;
+		if ((r = re_parse_cat(p)) < 0)
+			return -1;
+		n = re_node(p, RN_ALT, n, r);
+	}
+	return n;
+}
+
+/* compiling */
+
+static int
+re_emit(ReParse *p, int op, int x, int y)
+{
+	if (p->len >= RE_MAXPROG) {
+		p->err = "pattern too large";
+		return 0;
+	}
+	p->prog[p->len] = (struct EevoReInst_){ op, x, y };
+	return p->len++;
+}
+
+/* add instructions matching node to end of program, or matching the node's
+ * characters backwards if rev is set */
+static void
+re_compile(ReParse *p, int n, int rev)
+{
+	ReNode node = p->nodes[n];
+	int i, split, jmp;
+	if (p->err)
+		return;
+	switch (node.t) {
+	case RN_CLASS: re_emit(p, RE_CLASS, node.a, 0); break;
+	case RN_BOL:   re_emit(p, rev ? RE_EOL : RE_BOL, 0, 0); break;
+	case RN_EOL:   re_emit(p, rev ? RE_BOL : RE_EOL, 0, 0); break;
+	case RN_EMPTY: break;
+	case RN_CAT:
+		re_compile(p, rev ? node.b : node.a, rev);
+		re_compile(p, rev ? node.a : node.b, rev);
+		break;
+	case RN_ALT: /* split to both, first side jumps past second when done */
+		split = re_emit(p, RE_SPLIT, 0, 0);
+		re_compile(p, node.a, rev);
+		jmp = re_emit(p, RE_JMP, 0, 0);
+		re_compile(p, node.b, rev);
+		p->prog[split].x = split + 1, p->prog[split].y = jmp + 1;
+		p->prog[jmp].x = p->len;
+		break;
+	case RN_GROUP: /* captures are only found going forwards */
+		if (!rev)
+			re_emit(p, RE_SAVE, 2 * node.min, 0);
+		re_compile(p, node.a, rev);
+		if (!rev)
+			re_emit(p, RE_SAVE, 2 * node.min + 1, 0);
+		break;
+	case RN_REP: /* required copies, then loop or optional copies */
+		for (i = 0; i < node.min; i++)
+			re_compile(p, node.a, rev);
+		for (i = node.min; i < node.max || (node.max < 0 && i == node.min); i++) {
+			split = re_emit(p, RE_SPLIT, 0, 0);
+			re_compile(p, node.a, rev);
+			if (node.max < 0)
+				re_emit(p, RE_JMP, split, 0);
+			p->prog[split].x = split + 1, p->prog[split].y = p->len;
+			if (node.lazy) /* prefer skipping */
+				p->prog[split].x = p->len, p->prog[split].y = split + 1;
+		}
+		break;
+	}
+}
+
+/* compile whole program for tree, returns its length */
+static struct EevoReInst_ *
+re_program(ReParse *p, int root, int rev, int *len)
+{
+	if (!(p->prog = malloc(RE_MAXPROG * sizeof(struct EevoReInst_))))
+		perror("; malloc"), exit(1);
+	p->len = 0;
+	if (!rev) /* whole match is recorded as group 0 */
+		re_emit(p, RE_SAVE, 0, 0);
+	re_compile(p, root, rev);
+	if (!rev)
+		re_emit(p, RE_SAVE, 1, 0);
+	re_emit(p, RE_MATCH, 0, 0);
+	*len = p->len;
+	return realloc(p->prog, p->len * sizeof(struct EevoReInst_));
+}
+
+/* compile pattern of n characters, returns NULL with error set if invalid */
+static EevoRegex
+re_new(char *pat, size_t n, char **err)
+{
+	ReParse p = { 0 };
+	EevoRegex re;
+	size_t i;
+	int root = 0, len;
+	if (!(re = calloc(1, sizeof(struct EevoRegex_))) || !(re->pat = malloc(n + 1)))
+		perror("; malloc"), exit(1);
+	memcpy(re->pat, pat, n);
+	re->pat[n] = '\0';
+	p.s = re->pat, p.re = re;
+	for (i = 0; i < n && (len = utf8_size(pat + i, n - i)); i += len) ;
+	if (i < n)
+		p.err = "pattern is not valid UTF-8";
+	else if ((root = re_parse_alt(&p)) >= 0 && *p.s)
+		p.err = "unmatched )";
+	if (!p.err && strlen(re->pat) != n)
+		p.err = "pattern contains NUL byte";
+	if (!p.err)
+		re->prog = re_program(&p, root, 0, &re->len);
+	if (!p.err)
+		re->rprog = re_program(&p, root, 1, &re->rlen);
+	free(p.nodes);
+	if ((*err = p.err)) {
+		free(re->pat), free(re->prog), free(re->rprog), free(re->cls), free(re);
+		return NULL;
+	}
+	re->ncap = 2 * (p.ngroup + 1);
+	if (!(re->work = calloc(1, sizeof(struct EevoReWork_))) ||
+	    !(re->work->mark = calloc(re->len, sizeof(int))) ||
+	    !(re->work->stack = malloc((2 * re->len + 1) * sizeof(int))) ||
+	    !(re->work->list = malloc(re->len * sizeof(int))) ||
+	    !(re->work->clist = malloc(re->len * sizeof(*re->work->clist))) ||
+	    !(re->work->nlist = malloc(re->len * sizeof(*re->work->nlist))) ||
+	    !(re->work->caps = malloc((2 * re->len + 1) * re->ncap * sizeof(int))) ||
+	    !(re->work->groups = malloc(re->ncap * sizeof(int))))
+		perror("; malloc"), exit(1);
+	/* each thread keeps its captures in a block, the first is for new threads */
+	for (int i = 0; i < re->len; i++) {
+		re->work->clist[i].caps = re->work->caps + (2 * i + 1) * re->ncap;
+		re->work->nlist[i].caps = re->work->caps + (2 * i + 2) * re->ncap;
+	}
+	return re;
+}
+
+/* DFA */
+
+/* add threads of program reachable from pc without reading a character to
+ * list of n threads, returns new length. Threads already in the list this
+ * step are skipped, and once a match is reached lower priority threads are
+ * cut if cut is set. End of text assertions are followed if eol is set,
+ * otherwise they wait in the list until the end of the text is known */
+static int
+re_close(EevoRegex re, struct EevoReInst_ *prog, int pc, int bol, int eol, int cut,
+         int *list, int n)
+{
+	struct EevoReWork_ *w = re->work;
+	int top = 0;
+	w->stack[top++] = pc;
+	while (top && !(cut && w->matched)) {
+		if (w->mark[pc = w->stack[--top]] == w->gen)
+			continue;
+		w->mark[pc] = w->gen;
+		switch (prog[pc].op) {
+		case RE_SPLIT: /* first choice is taken first */
+			w->stack[top++] = prog[pc].y;
+			w->stack[top++] = prog[pc].x;
+			break;
+		case RE_JMP:  w->stack[top++] = prog[pc].x; break;
+		case RE_SAVE: w->stack[top++] = pc + 1; break;
+		case RE_BOL:
+			if (bol)
+				w->stack[top++] = pc + 1;
+			break;
+		case RE_EOL:
+			if (eol) {
+				w->stack[top++] = pc + 1;
+				break;
+			}
+			list[n++] = pc;
+			break;
+		case RE_MATCH:
+			w->matched = 1;
+			/* fallthrough */
+		default:
+			list[n++] = pc;
+		}
+	}
+	return n;
+}
+
+static struct EevoReDfa_ *
+re_dfa(EevoRegex re, int mode)
+{
+	if (!re->dfa[mode]) {
+		if (!(re->dfa[mode] = calloc(1, sizeof(struct EevoReDfa_))))
+			perror("; calloc"), exit(1);
+		re->dfa[mode]->mode = mode;
+		re->dfa[mode]->prog = mode == RE_REVERSE ? re->rprog : re->prog;
+	}
+	return re->dfa[mode];
+}
+
+/* free every cached state, used once cache grows too large */
+static void
+re_dfa_flush(struct EevoReDfa_ *d)
+{
+	for (int i = 0; i < RE_BUCKETS; i++)
+		for (ReState s = d->buckets[i], next; s; s = next) {
+			next = s->chain;
+			free(s);
+		}
+	memset(d->buckets, 0, sizeof(d->buckets));
+	d->start[0] = d->start[1] = NULL;
+	d->len = 0;
+	d->flushes++;
+}
+
+/* return cached state for list of threads and flags, adding it if new */
+static ReState
+re_state(struct EevoReDfa_ *d, int *list, int n, int flags, int match)
+{
+	ReState s;
+	uint32_t h = flags;
+	for (int i = 0; i < n; i++)
+		h = h * 31 + list[i];
+	for (s = d->buckets[h % RE_BUCKETS]; s; s = s->chain)
+		if (s->hash == h && s->flags == flags && s->n == n &&
+		    !memcmp(s->pcs, list, n * sizeof(int)))
+			return s;
+	if (d->len == RE_MAXSTATES)
+		re_dfa_flush(d);
+	if (!(s = calloc(1, sizeof(struct ReState_) + n * sizeof(int))))
+		perror("; calloc"), exit(1);
+	memcpy(s->pcs, list, n * sizeof(int));
+	s->n = n, s->hash = h, s->flags = flags, s->match = match, s->endmatch = -1;
+	s->chain = d->buckets[h % RE_BUCKETS];
+	d->buckets[h % RE_BUCKETS] = s;
+	d->len++;
+	return s;
+}
+
+static ReState
+re_start(EevoRegex re, struct EevoReDfa_ *d, int bol)
+{
+	int n, cut = d->mode == RE_SEARCH;
+	if (!d->start[bol]) {
+		re->work->gen++, re->work->matched = 0;
+		n = re_close(re, d->prog, 0, bol, 0, cut, re->work->list, 0);
+		d->start[bol] = re_state(d, re->work->list, n, (bol ? RE_BEGIN : 0) |
+		                         (cut ? RE_SEARCHING : 0), re->work->matched);
+	}
+	return d->start[bol];
+}
+
+/* state after reading byte c in state s */
+static ReState
+re_step(EevoRegex re, struct EevoReDfa_ *d, ReState s, int c)
+{
+	struct EevoReWork_ *w = re->work;
+	struct EevoReInst_ *prog = d->prog;
+	int n = 0, flushes = d->flushes, cut = d->mode == RE_SEARCH;
+	int flags = s->flags & ~RE_BEGIN;
+	ReState next;
+	w->gen++, w->matched = 0;
+	for (int i = 0; i < s->n && !(cut && w->matched); i++)
+		if (prog[s->pcs[i]].op == RE_CLASS && RE_HAS(re->cls[prog[s->pcs[i]].x], c))
+			n = re_close(re, prog, s->pcs[i] + 1, 0, 0, cut, w->list, n);
+	if (s->match) /* leftmost match already found */
+		flags &= ~RE_SEARCHING;
+	if (flags & RE_SEARCHING) /* new match could start after c */
+		n = re_close(re, prog, 0, 0, 0, cut, w->list, n);
+	next = re_state(d, w->list, n, flags, w->matched);
+	if (d->flushes == flushes) /* otherwise s was freed with the rest of the cache */
+		s->next[c] = next;
+	return next;
+}
+
+/* return 1 if state matches once the end of the text is reached */
+static int
+re_endmatch(EevoRegex re, struct EevoReDfa_ *d, ReState s)
+{
+	if (s->endmatch < 0) {
+		re->work->gen++, re->work->matched = 0;
+		for (int i = 0; i < s->n && !re->work->matched; i++)
+			if (d->prog[s->pcs[i]].op == RE_MATCH)
+				re->work->matched = 1;
+			else if (d->prog[s->pcs[i]].op == RE_EOL)
+				re_close(re, d->prog, s->pcs[i] + 1, s->flags & RE_BEGIN, 1, 1,
+				         re->work->list, 0);
+		s->endmatch = re->work->matched;
+	}
+	return s->endmatch;
+}
+
+/* return state after reading byte c */
+static ReState
+re_next(EevoRegex re, struct EevoReDfa_ *d, ReState s, char c)
+{
+	ReState next = s->next[(unsigned char)c];
+	return next ? next : re_step(re, d, s, (unsigned char)c);
+}
+
+/* return 1 if no more matches can be found from state */
+#define RE_DEAD(S) (!(S)->n && !((S)->flags & RE_SEARCHING))
+
+/* return where leftmost match in s of length n found from pos ends, or -1 if
+ * there is none. Whole matches only succeed if this is n */
+static long
+re_dfa_end(EevoRegex re, int mode, char *s, size_t pos, size_t n)
+{
+	struct EevoReDfa_ *d = re_dfa(re, mode);
+	ReState st = re_start(re, d, pos == 0);
+	long end = st->match ? (long)pos : -1;
+	for (size_t i = pos; i < n; i++) {
+		if (RE_DEAD(st = re_next(re, d, st, s[i])))
+			return end;
+		if (st->match)
+			end = i + 1;
+	}
+	return re_endmatch(re, d, st) ? (long)n : end;
+}
+
+/* return where leftmost match ending at end starts, which is the furthest
+ * back the reversed program matches from end without going before pos */
+static size_t
+re_dfa_start(EevoRegex re, char *s, size_t pos, size_t end, size_t n)
+{
+	struct EevoReDfa_ *d = re_dfa(re, RE_REVERSE);
+	ReState st = re_start(re, d, end == n);
+	size_t start = end, i;
+	for (i = end; i > pos; i--) {
+		if (RE_DEAD(st = re_next(re, d, st, s[i-1])))
+			return start;
+		if (st->match)
+			start = i - 1;
+	}
+	return !i && re_endmatch(re, d, st) ? 0 : start;
+}
+
+/* Pike VM */
+
+/* add thread at pc with given captures to list, following jumps and saving
+ * positions, i is the position in the text s of length n */
+static void
+re_pike_add(EevoRegex re, int *len, int pc, int *caps, size_t i, size_t n)
+{
+	struct EevoReWork_ *w = re->work;
+	int old;
+	if (w->mark[pc] == w->gen)
+		return;
+	w->mark[pc] = w->gen;
+	switch (re->prog[pc].op) {
+	case RE_SPLIT:
+		re_pike_add(re, len, re->prog[pc].x, caps, i, n);
+		re_pike_add(re, len, re->prog[pc].y, caps, i, n);
+		break;
+	case RE_JMP:
+		re_pike_add(re, len, re->prog[pc].x, caps, i, n);
+		break;
+	case RE_SAVE: /* restored after so caller's captures are unchanged */
+		old = caps[re->prog[pc].x];
+		caps[re->prog[pc].x] = i;
+		re_pike_add(re, len, pc + 1, caps, i, n);
+		caps[re->prog[pc].x] = old;
+		break;
+	case RE_BOL:
+		if (i == 0)
+			re_pike_add(re, len, pc + 1, caps, i, n);
+		break;
+	case RE_EOL:
+		if (i == n)
+			re_pike_add(re, len, pc + 1, caps, i, n);
+		break;
+	default:
+		w->nlist[*len].pc = pc;
+		memcpy(w->nlist[*len].caps, caps, re->ncap * sizeof(int));
+		(*len)++;
+	}
+}
+
+/* find captures of leftmost match in s of length n searching from pos, where
+ * the match is already known to end at end, returns 0 if there is none */
+static int
+re_pike(EevoRegex re, char *s, size_t pos, size_t end, size_t n, int *caps)
+{
+	struct EevoReWork_ *w = re->work;
+	void *tmp;
+	int cn = 0, nn, matched = 0, pc;
+	for (int i = 0; i < re->ncap; i++)
+		caps[i] = -1;
+	w->gen++;
+	re_pike_add(re, &cn, 0, caps, pos, n);
+	for (size_t i = pos; ; i++) {
+		tmp = w->clist, w->clist = w->nlist, w->nlist = tmp; /* threads for i now in clist */
+		w->gen++, nn = 0;
+		for (int k = 0; k < cn; k++) {
+			pc = w->clist[k].pc;
+			if (re->prog[pc].op == RE_MATCH) { /* lower priority threads are cut */
+				memcpy(caps, w->clist[k].caps, re->ncap * sizeof(int));
+				matched = 1;
+				break;
+			}
+			if (i < end && re->prog[pc].op == RE_CLASS &&
+			    RE_HAS(re->cls[re->prog[pc].x], (unsigned char)s[i]))
+				re_pike_add(re, &nn, pc + 1, w->clist[k].caps, i + 1, n);
+		}
+		if (i >= end)
+			break;
+		if (!matched) { /* new match could start after s[i] */
+			for (int k = 0; k < re->ncap; k++)
+				w->caps[k] = -1;
+			re_pike_add(re, &nn, 0, w->caps, i + 1, n);
+		}
+		if (!(cn = nn))
+			break;
+	}
+	return matched;
+}
+
+/* find leftmost match in s of length n searching from pos, with its bounds
+ * put in the regex's groups, followed by its captures if caps is set,
+ * returns 0 if there is none */
+static int
+re_find(EevoRegex re, char *s, size_t pos, size_t n, int caps)
+{
+	long end = re_dfa_end(re, RE_SEARCH, s, pos, n);
+	if (end < 0)
+		return 0;
+	pos = re_dfa_start(re, s, pos, end, n);
+	if (caps && re->ncap > 2) /* NFA is only run over text of match */
+		return re_pike(re, s, pos, end, n, re->work->groups);
+	re->work->groups[0] = pos, re->work->groups[1] = end;
+	return 1;
+}
+
+/* get optional index to start searching from as third argument */
+#define RE_START(NAME, ARGS, N, START) do {                                \
+	int len = eevo_lstlen(ARGS);                                            \
+	if (len != 2 && len != 3)                                               \
+		eevo_warnf(NAME ": expected 2 or 3 arguments, received %d", len); \
+	eevo_arg_type(fst(ARGS), NAME, EEVO_REGEX);                             \
+	eevo_arg_type(snd(ARGS), NAME, EEVO_CHARS);                             \
+	N = text_len(snd(ARGS)), START = 0;                                     \
+	if (len == 3) {                                                         \
+		eevo_arg_type(fst(rrst(ARGS)), NAME, EEVO_INT);                 \
+		if (num(fst(rrst(ARGS))) < 0 || num(fst(rrst(ARGS))) > N)       \
+			eevo_warnf(NAME ": index %d out of bounds of string of length %d", \
+			           (int)num(fst(rrst(ARGS))), (int)N);          \
+		START = num(fst(rrst(ARGS)));                                   \
+	}                                                                       \
+} while (0)
+
+/* compile pattern into regular expression */
+static Eevo
+prim_Regex(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret;
+	EevoRegex re;
+	char *err;
+	eevo_arg_num(args, "Regex", 1);
+	if (fst(args)->t == EEVO_REGEX)
+		return fst(args);
+	eevo_arg_type(fst(args), "Regex", EEVO_CHARS);
+	if (!(re = re_new(text_chars(fst(args)), text_len(fst(args)), &err)))
+		eevo_warnf("Regex: %s in pattern '%.*s'", err,
+		           (int)text_len(fst(args)), text_chars(fst(args)));
+	ret = eevo_val(EEVO_REGEX);
+	ret->v.re = re;
+	return ret;
+}
+
+/* return True if regex matches all of string */
+static Eevo
+prim_rematchp(EevoSt st, EevoRec env, Eevo args)
+{
+	size_t n;
+	eevo_arg_num(args, "re-match?", 2);
+	eevo_arg_type(fst(args), "re-match?", EEVO_REGEX);
+	eevo_arg_type(snd(args), "re-match?", EEVO_CHARS);
+	n = text_len(snd(args));
+	return re_dfa_end(fst(args)->v.re, RE_FULL, text_chars(snd(args)), 0, n) == (long)n ? True : Nil;
+}
+
+/* return view of first match of regex in string, or Nil if there is none */
+static Eevo
+prim_research(EevoSt st, EevoRec env, Eevo args)
+{
+	EevoRegex re;
+	size_t n, start;
+	RE_START("re-search", args, n, start);
+	re = fst(args)->v.re;
+	if (!re_find(re, text_chars(snd(args)), start, n, 0))
+		return Nil;
+	return eevo_strview(snd(args), text_chars(snd(args)) + re->work->groups[0],
+	                    re->work->groups[1] - re->work->groups[0]);
+}
+
+/* return list of views of every match of regex in string which don't overlap */
+static Eevo
+prim_refindall(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret = eevo_pair(NULL, Nil), pos = ret;
+	EevoRegex re;
+	char *s;
+	size_t i, n, start, end;
+	RE_START("re-find-all", args, n, start);
+	re = fst(args)->v.re, s = text_chars(snd(args));
+	for (i = start; i <= n && re_find(re, s, i, n, 0); ) {
+		start = re->work->groups[0], end = re->work->groups[1];
+		pos = rst(pos) = eevo_pair(eevo_strview(snd(args), s + start, end - start), Nil);
+		/* step past empty match, by a whole character */
+		i = end > start ? end : end < n ? end + UTF8_NEXT(s + end, n - end) : end + 1;
+	}
+	return rst(ret);
+}
+
+/* return list of views of whole first match followed by each group, or Nil
+ * for groups not part of the match, Nil if regex doesn't match at all */
+static Eevo
+prim_recaptures(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret = eevo_pair(NULL, Nil), pos = ret;
+	EevoRegex re;
+	char *s;
+	int *g;
+	size_t n, start;
+	RE_START("re-captures", args, n, start);
+	re = fst(args)->v.re, s = text_chars(snd(args)), g = re->work->groups;
+	if (!re_find(re, s, start, n, 1))
+		return Nil;
+	for (int i = 0; i < re->ncap; i += 2)
+		pos = rst(pos) = eevo_pair(g[i] < 0 || g[i+1] < 0 ? Nil :
+		                           eevo_strview(snd(args), s + g[i], g[i+1] - g[i]), Nil);
+	return rst(ret);
+}
+
+void
+eevo_env_regex(EevoSt st)
+{
+	st->types[24]->v.t.func = eevo_prim(EEVO_PRIM, prim_Regex, "Regex");
+	eevo_env_name_prim(re-match?,    rematchp);
+	eevo_env_name_prim(re-search,    research);
+	eevo_env_name_prim(re-find-all,  refindall);
+	eevo_env_name_prim(re-captures,  recaptures);
+}
@@ -21,7 +21,172 @@
 
 typedef Eevo (*MkFn)(EevoSt, char*);
 
-/* TODO string tib: lower upper capitalize strpos strsub skipto snipto (python: dir(str))*/
+/* TODO string tib: capitalize strsub skipto snipto (python: dir(str))*/
+
+/* return first occurrence of sub in s, or NULL if not found. Candidates are
+ * found with memchr, which the C library vectorizes, and the last character
+ * is checked before comparing the rest */
+static char *
+str_find(char *s, size_t n, char *sub, size_t m)
+{
+	char *p, *end;
+	if (!m)
+		return s;
+	if (m > n)
+		return NULL;
+	for (p = s, end = s + n - m; p <= end && (p = memchr(p, sub[0], end - p + 1)); p++)
+		if (p[m - 1] == sub[m - 1] && !memcmp(p + 1, sub + 1, m - 1))
+			return p;
+	return NULL;
+}
+
+/* return new string copied from first n characters of s, not interned */
+static Eevo
+str_sub(char *s, size_t n)
+{
+	char *ret;
+	if (!(ret = malloc(n + 1)))
+		perror("; malloc"), exit(1);
+	memcpy(ret, s, n);
+	ret[n] = '\0';
+	return str_new(ret);
+}
+
+/* UTF-8 */
+
+static struct EevoUtf8_ utf8_ascii; /* shared by all strings which are only ASCII */
+
+/* return 1 if n bytes of s are all ASCII. Blocks are or'ed together a word
+ * at a time, which compilers turn into SIMD, and only checked between blocks */
+static int
+utf8_isascii(const char *s, size_t n)
+{
+	uint64_t w, acc = 0;
+	size_t i = 0;
+	for (; i + 256 <= n; i += 256) {
+		for (int j = 0; j < 256; j += 8) {
+			memcpy(&w, s + i + j, 8);
+			acc |= w;
+		}
+		if (acc & 0x8080808080808080)
+			return 0;
+	}
+	for (; i < n; i++)
+		acc |= (unsigned char)s[i];
+	return !(acc & 0x8080808080808080);
+}
+
+/* return number of bytes in valid UTF-8 character at start of s of n bytes,
+ * or 0 if it is invalid, which is then counted as a character of one byte */
+static int
+utf8_size(const char *str, size_t n)
+{
+	const unsigned char *s = (const unsigned char *)str;
+	int len;
+	if (s[0] < 0x80)
+		return 1;
+	if (s[0] < 0xC2 || s[0] > 0xF4) /* continuation byte or overlong 2 byte start */
+		return 0;
+	len = s[0] < 0xE0 ? 2 : s[0] < 0xF0 ? 3 : 4;
+	if ((size_t)len > n)
+		return 0;
+	for (int i = 1; i < len; i++)
+		if ((s[i] & 0xC0) != 0x80)
+			return 0;
+	if ((s[0] == 0xE0 && s[1] < 0xA0) || (s[0] == 0xF0 && s[1] < 0x90) || /* overlong */
+	    (s[0] == 0xED && s[1] > 0x9F) || /* surrogate */
+	    (s[0] == 0xF4 && s[1] > 0x8F))   /* above U+10FFFF */
+		return 0;
+	return len;
+}
+
+#define UTF8_NEXT(S, N) (utf8_size(S, N) ? utf8_size(S, N) : 1)
+
+/* return code points of n bytes of s, only ASCII strings skip the index */
+static EevoUtf8
+utf8_new(char *s, size_t n)
+{
+	EevoUtf8 u;
+	size_t i, cp;
+	if (utf8_isascii(s, n))
+		return &utf8_ascii;
+	if (!(u = malloc(sizeof(struct EevoUtf8_))) ||
+	    !(u->index = malloc((n / EEVO_UTF8_STRIDE + 1) * sizeof(size_t))))
+		perror("; malloc"), exit(1);
+	for (i = cp = 0; i < n; cp++) {
+		if (cp % EEVO_UTF8_STRIDE == 0)
+			u->index[cp / EEVO_UTF8_STRIDE] = i;
+		i += UTF8_NEXT(s + i, n - i);
+	}
+	if (cp % EEVO_UTF8_STRIDE == 0) /* offset of end */
+		u->index[cp / EEVO_UTF8_STRIDE] = n;
+	u->len = cp;
+	return u;
+}
+
+/* return code points of text, kept with strings, symbols and views once found.
+ * Views of ASCII strings are ASCII without looking at their characters */
+static EevoUtf8
+utf8_get(Eevo v)
+{
+	if (v->t == EEVO_STRVIEW) {
+		if (!v->v.sv.utf8)
+			v->v.sv.utf8 = v->v.sv.parent->t & EEVO_TEXT &&
+			               utf8_get(v->v.sv.parent) == &utf8_ascii ?
+			               &utf8_ascii : utf8_new(v->v.sv.s, v->v.sv.len);
+		return v->v.sv.utf8;
+	}
+	if (!v->v.str.utf8)
+		v->v.str.utf8 = utf8_new(v->v.s, strlen(v->v.s));
+	return v->v.str.utf8;
+}
+
+/* return byte offset of code point i in s of n bytes */
+static size_t
+utf8_offset(EevoUtf8 u, char *s, size_t n, size_t i)
+{
+	size_t off;
+	if (u == &utf8_ascii)
+		return i;
+	off = u->index[i / EEVO_UTF8_STRIDE];
+	for (i %= EEVO_UTF8_STRIDE; i; i--)
+		off += UTF8_NEXT(s + off, n - off);
+	return off;
+}
+
+/* return code point of valid UTF-8 character of len bytes */
+static int
+utf8_decode(const char *str, int len)
+{
+	const unsigned char *s = (const unsigned char *)str;
+	int c = len == 1 ? s[0] : s[0] & (0x7F >> len);
+	for (int i = 1; i < len; i++)
+		c = c << 6 | (s[i] & 0x3F);
+	return c;
+}
+
+/* write code point c as UTF-8 to s, returns number of bytes, or 0 if invalid */
+static int
+utf8_encode(char *s, long c)
+{
+	if (c < 0 || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF))
+		return 0;
+	if (c < 0x80) {
+		s[0] = c;
+		return 1;
+	}
+	if (c < 0x800) {
+		s[0] = 0xC0 | c >> 6, s[1] = 0x80 | (c & 0x3F);
+		return 2;
+	}
+	if (c < 0x10000) {
+		s[0] = 0xE0 | c >> 12, s[1] = 0x80 | (c >> 6 & 0x3F), s[2] = 0x80 | (c & 0x3F);
+		return 3;
+	}
+	s[0] = 0xF0 | c >> 18, s[1] = 0x80 | (c >> 12 & 0x3F);
+	s[2] = 0x80 | (c >> 6 & 0x3F), s[3] = 0x80 | (c & 0x3F);
+	return 4;
+}
 
 /* convert all args to a string */
 static Eevo
@@ -47,59 +212,469 @@ static Eevo
 prim_strlen(EevoSt st, EevoRec env, Eevo args)
 {
 	eevo_arg_min(args, "strlen", 1);
-	eevo_arg_type(fst(args), "strlen", EEVO_STR | EEVO_SYM);
-	return eevo_int(strlen(fst(args)->v.s));
+	eevo_arg_type(fst(args), "strlen", EEVO_CHARS | EEVO_STRBUF | EEVO_ROPE);
+	return eevo_int(text_len(fst(args)));
 }
 
-/* perform interpolation on explicit string, evaluating anything inside curly braces */
-/* FIXME nested strings shouldn't need to be escaped*/
+/* add characters of value to end of string buffer, converting it to a string
+ * first unless it already is one */
+static void
+strbuf_add(Eevo buf, Eevo v)
+{
+	char *s = NULL;
+	size_t n;
+	if (v->t & (EEVO_CHARS | EEVO_STRBUF | EEVO_ROPE))
+		n = text_len(v);
+	else
+		n = strlen(s = eevo_print(v));
+	if (buf->v.sb.len + n >= buf->v.sb.cap) {
+		buf->v.sb.cap = 2 * (buf->v.sb.len + n);
+		if (!(buf->v.sb.s = realloc(buf->v.sb.s, buf->v.sb.cap)))
+			perror("; realloc"), exit(1);
+	}
+	if (v->t == EEVO_ROPE)
+		rope_fill(v, buf->v.sb.s + buf->v.sb.len);
+	else /* buffer could be added to itself, so only read from it after growing */
+		memcpy(buf->v.sb.s + buf->v.sb.len, s ? s : text_chars(v), n);
+	buf->v.sb.s[buf->v.sb.len += n] = '\0';
+	free(s);
+}
+
+/* create string buffer from the given values */
 static Eevo
-form_strfmt(EevoSt st, EevoRec env, Eevo args)
+prim_StrBuf(EevoSt st, EevoRec env, Eevo args)
 {
-	char *ret, *str;
-	int ret_len, ret_cap, pos = 0;
-	Eevo v;
-	eevo_arg_num(args, "strfmt", 1);
-	eevo_arg_type(fst(args), "strfmt", EEVO_STR);
+	Eevo ret = eevo_strbuf(64);
+	for (; args->t == EEVO_PAIR; args = rst(args))
+		strbuf_add(ret, fst(args));
+	return ret;
+}
+
+/* add values to end of string buffer */
+static Eevo
+prim_strbufadd(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_min(args, "strbuf-add!", 1);
+	eevo_arg_type(fst(args), "strbuf-add!", EEVO_STRBUF);
+	for (Eevo v = rst(args); v->t == EEVO_PAIR; v = rst(v))
+		strbuf_add(fst(args), fst(v));
+	return Void;
+}
+
+/* empty string buffer, keeping its space to be reused */
+static Eevo
+prim_strbufclear(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "strbuf-clear!", 1);
+	eevo_arg_type(fst(args), "strbuf-clear!", EEVO_STRBUF);
+	fst(args)->v.sb.s[fst(args)->v.sb.len = 0] = '\0';
+	return Void;
+}
+
+/* create rope joining the given values, strings, views and ropes are shared instead
+ * of copied, anything else is converted to a string first */
+static Eevo
+prim_Rope(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo v, ret = NULL, empty = eevo_str(st, "");
+	for (; args->t == EEVO_PAIR; args = rst(args)) {
+		v = fst(args);
+		if (!(v->t & (EEVO_CHARS | EEVO_ROPE))) /* string buffers can still change */
+			v = str_new(eevo_print(v));
+		ret = ret ? eevo_rope(ret, v) : v;
+	}
+	if (!ret || ret->t != EEVO_ROPE)
+		return eevo_rope(ret ? ret : empty, empty);
+	return ret;
+}
+
+/* view of characters from start up to but not including optional end index,
+ * negative indices count back from the end of the string */
+static Eevo
+prim_strslice(EevoSt st, EevoRec env, Eevo args)
+{
+	int start, end, n, len = eevo_lstlen(args);
+	if (len != 2 && len != 3)
+		eevo_warnf("str-slice: expected 2 or 3 arguments, received %d", len);
+	eevo_arg_type(fst(args), "str-slice", EEVO_CHARS);
+	eevo_arg_type(snd(args), "str-slice", EEVO_INT);
+	n = text_len(fst(args));
+	start = num(snd(args)), end = n;
+	if (len == 3) {
+		eevo_arg_type(fst(rrst(args)), "str-slice", EEVO_INT);
+		end = num(fst(rrst(args)));
+	}
+	if (start < 0) start += n;
+	if (end < 0)   end += n;
+	if (start < 0 || end > n || start > end)
+		eevo_warnf("str-slice: range %d..%d out of bounds of string of length %d",
+		           start, end, n);
+	return eevo_strview(fst(args), text_chars(fst(args)) + start, end - start);
+}
+
+/* return index of first occurrence of substring, starting search at optional
+ * index, or Nil if not found */
+static Eevo
+prim_strfind(EevoSt st, EevoRec env, Eevo args)
+{
+	char *s, *p;
+	size_t n, start = 0;
+	int len = eevo_lstlen(args);
+	if (len != 2 && len != 3)
+		eevo_warnf("str-find: expected 2 or 3 arguments, received %d", len);
+	eevo_arg_type(fst(args), "str-find", EEVO_CHARS);
+	eevo_arg_type(snd(args), "str-find", EEVO_CHARS);
+	s = text_chars(fst(args)), n = text_len(fst(args));
+	if (len == 3) {
+		eevo_arg_type(fst(rrst(args)), "str-find", EEVO_INT);
+		if (num(fst(rrst(args))) < 0 || num(fst(rrst(args))) > n)
+			eevo_warnf("str-find: index %d out of bounds of string of length %d",
+			           (int)num(fst(rrst(args))), (int)n);
+		start = num(fst(rrst(args)));
+	}
+	if (!(p = str_find(s + start, n - start, text_chars(snd(args)), text_len(snd(args)))))
+		return Nil;
+	return eevo_int(p - s);
+}
+
+static Eevo
+prim_strcontainsp(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "str-contains?", 2);
+	eevo_arg_type(fst(args), "str-contains?", EEVO_CHARS);
+	eevo_arg_type(snd(args), "str-contains?", EEVO_CHARS);
+	return str_find(text_chars(fst(args)), text_len(fst(args)),
+	                text_chars(snd(args)), text_len(snd(args))) ? True : Nil;
+}
+
+static Eevo
+prim_strprefixp(EevoSt st, EevoRec env, Eevo args)
+{
+	size_t m;
+	eevo_arg_num(args, "str-prefix?", 2);
+	eevo_arg_type(fst(args), "str-prefix?", EEVO_CHARS);
+	eevo_arg_type(snd(args), "str-prefix?", EEVO_CHARS);
+	m = text_len(snd(args));
+	return m <= text_len(fst(args)) &&
+	       !memcmp(text_chars(fst(args)), text_chars(snd(args)), m) ? True : Nil;
+}
+
+static Eevo
+prim_strsuffixp(EevoSt st, EevoRec env, Eevo args)
+{
+	size_t n, m;
+	eevo_arg_num(args, "str-suffix?", 2);
+	eevo_arg_type(fst(args), "str-suffix?", EEVO_CHARS);
+	eevo_arg_type(snd(args), "str-suffix?", EEVO_CHARS);
+	n = text_len(fst(args)), m = text_len(snd(args));
+	return m <= n && !memcmp(text_chars(fst(args)) + n - m, text_chars(snd(args)), m) ? True : Nil;
+}
+
+/* split string at each separator, or at runs of white space if none given,
+ * returning views of the original string instead of copies */
+static Eevo
+prim_strsplit(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret = eevo_pair(NULL, Nil), pos = ret;
+	char *s, *end, *sep, *p;
+	size_t n, m;
+	int len = eevo_lstlen(args);
+	if (len != 1 && len != 2)
+		eevo_warnf("str-split: expected 1 or 2 arguments, received %d", len);
+	eevo_arg_type(fst(args), "str-split", EEVO_CHARS);
+	s = text_chars(fst(args)), n = text_len(fst(args));
+	if (len == 1) {
+		for (end = s + n;;) {
+			while (s < end && isspace((unsigned char)*s))
+				s++;
+			if (s == end)
+				return rst(ret);
+			for (p = s; p < end && !isspace((unsigned char)*p); p++) ;
+			pos = rst(pos) = eevo_pair(eevo_strview(fst(args), s, p - s), Nil);
+			s = p;
+		}
+	}
+	eevo_arg_type(snd(args), "str-split", EEVO_CHARS);
+	sep = text_chars(snd(args)), m = text_len(snd(args));
+	if (!m)
+		eevo_warn("str-split: expected non-empty separator");
+	for (; (p = str_find(s, n, sep, m)); n -= p + m - s, s = p + m)
+		pos = rst(pos) = eevo_pair(eevo_strview(fst(args), s, p - s), Nil);
+	rst(pos) = eevo_pair(eevo_strview(fst(args), s, n), Nil);
+	return rst(ret);
+}
 
-	str = fst(args)->v.s;
-	ret_len = strlen(str), ret_cap = 2*ret_len;
-	if (!(ret = malloc(sizeof(char) * ret_cap)))
+/* join list or vector of strings into one, with optional separator between */
+static Eevo
+prim_strjoin(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo seq, v;
+	char *sep = "", *ret, *p;
+	size_t n = 0, m = 0;
+	int i = 0, c = 0, len = eevo_lstlen(args);
+	if (len != 1 && len != 2)
+		eevo_warnf("str-join: expected 1 or 2 arguments, received %d", len);
+	eevo_arg_type(fst(args), "str-join", EEVO_LIST | EEVO_VEC | EEVO_PVEC);
+	if (len == 2) {
+		eevo_arg_type(snd(args), "str-join", EEVO_CHARS);
+		sep = text_chars(snd(args)), m = text_len(snd(args));
+	}
+	for (seq = fst(args); seq_next(&seq, &i, &v); c++) {
+		eevo_arg_type(v, "str-join", EEVO_CHARS);
+		n += text_len(v) + (c ? m : 0);
+	}
+	if (!(ret = p = malloc(n + 1)))
+		perror("; malloc"), exit(1);
+	for (i = c = 0, seq = fst(args); seq_next(&seq, &i, &v); c++) {
+		if (c)
+			memcpy(p, sep, m), p += m;
+		n = text_len(v);
+		memcpy(p, text_chars(v), n), p += n;
+	}
+	*p = '\0';
+	return str_new(ret);
+}
+
+/* replace every occurrence of old substring with new one */
+static Eevo
+prim_strreplace(EevoSt st, EevoRec env, Eevo args)
+{
+	char *s, *old, *new, *ret, *p, *q;
+	size_t n, m, k, c = 0;
+	eevo_arg_num(args, "str-replace", 3);
+	eevo_arg_type(fst(args), "str-replace", EEVO_CHARS);
+	eevo_arg_type(snd(args), "str-replace", EEVO_CHARS);
+	eevo_arg_type(fst(rrst(args)), "str-replace", EEVO_CHARS);
+	s = text_chars(fst(args)), old = text_chars(snd(args)), new = text_chars(fst(rrst(args)));
+	n = text_len(fst(args)), m = text_len(snd(args)), k = text_len(fst(rrst(args)));
+	if (!m)
+		eevo_warn("str-replace: expected non-empty substring to replace");
+	for (p = s; (p = str_find(p, n - (p - s), old, m)); p += m)
+		c++;
+	if (!(ret = q = malloc(n - c * m + c * k + 1)))
 		perror("; malloc"), exit(1);
+	for (; (p = str_find(s, n, old, m)); n -= p + m - s, s = p + m) {
+		memcpy(q, s, p - s), q += p - s;
+		memcpy(q, new, k), q += k;
+	}
+	memcpy(q, s, n);
+	q[n] = '\0';
+	return str_new(ret);
+}
+
+/* view of string without white space at its start and end */
+static Eevo
+prim_strtrim(EevoSt st, EevoRec env, Eevo args)
+{
+	char *s, *end;
+	eevo_arg_num(args, "str-trim", 1);
+	eevo_arg_type(fst(args), "str-trim", EEVO_CHARS);
+	s = text_chars(fst(args)), end = s + text_len(fst(args));
+	for (; s < end && isspace((unsigned char)*s); s++) ;
+	for (; end > s && isspace((unsigned char)end[-1]); end--) ;
+	return eevo_strview(fst(args), s, end - s);
+}
+
+/* number of UTF-8 characters in string, unlike strlen which counts bytes */
+static Eevo
+prim_strlength(EevoSt st, EevoRec env, Eevo args)
+{
+	EevoUtf8 u;
+	eevo_arg_num(args, "str-length", 1);
+	eevo_arg_type(fst(args), "str-length", EEVO_CHARS);
+	if ((u = utf8_get(fst(args))) == &utf8_ascii)
+		return eevo_int(text_len(fst(args)));
+	return eevo_int(u->len);
+}
 
-	while (*str)
-		if (*str == '{' && str[1] != '{') {
-			int l;
-			char *file = st->file;
-			size_t filec = st->filec;
-			char *s;
-			st->file = ++str, st->filec = 0;
-			/* TODO skip until } to allow for comments */
-			if (!(v = read_pair(st, '}')))
-				return NULL;
-			str += st->filec;
-			st->file = file, st->filec = filec;
-
-			if (!(v = eevo_eval_list(st, env, v))) /* TODO sandboxed eval, no mutable procs */
-				return NULL;
-			if (!(s = eevo_print(v)))
-				return NULL;
+/* view of characters of string from start up to but not including optional
+ * end, counting UTF-8 characters instead of bytes, negative from the end */
+static Eevo
+prim_substr(EevoSt st, EevoRec env, Eevo args)
+{
+	EevoUtf8 u;
+	char *s;
+	size_t n;
+	int start, end, len = eevo_lstlen(args), cps;
+	if (len != 2 && len != 3)
+		eevo_warnf("substr: expected 2 or 3 arguments, received %d", len);
+	eevo_arg_type(fst(args), "substr", EEVO_CHARS);
+	eevo_arg_type(snd(args), "substr", EEVO_INT);
+	if (len == 3)
+		eevo_arg_type(fst(rrst(args)), "substr", EEVO_INT);
+	s = text_chars(fst(args)), n = text_len(fst(args));
+	u = utf8_get(fst(args));
+	cps = u == &utf8_ascii ? (int)n : (int)u->len;
+	start = num(snd(args)), end = len == 3 ? num(fst(rrst(args))) : cps;
+	if (start < 0) start += cps;
+	if (end < 0)   end += cps;
+	if (start < 0 || end > cps || start > end)
+		eevo_warnf("substr: range %d..%d out of bounds of string of length %d",
+		           start, end, cps);
+	start = utf8_offset(u, s, n, start);
+	end = utf8_offset(u, s, n, end);
+	return eevo_strview(fst(args), s + start, end - start);
+}
+
+/* view of UTF-8 character of string at index, negative counts from the end */
+static Eevo
+prim_charat(EevoSt st, EevoRec env, Eevo args)
+{
+	EevoUtf8 u;
+	char *s;
+	size_t n, off;
+	int i, cps;
+	eevo_arg_num(args, "char-at", 2);
+	eevo_arg_type(fst(args), "char-at", EEVO_CHARS);
+	eevo_arg_type(snd(args), "char-at", EEVO_INT);
+	s = text_chars(fst(args)), n = text_len(fst(args));
+	u = utf8_get(fst(args));
+	cps = u == &utf8_ascii ? (int)n : (int)u->len;
+	if ((i = num(snd(args))) < 0)
+		i += cps;
+	if (i < 0 || i >= cps)
+		eevo_warnf("char-at: index %d out of bounds of string of length %d",
+		           (int)num(snd(args)), cps);
+	off = utf8_offset(u, s, n, i);
+	return eevo_strview(fst(args), s + off, UTF8_NEXT(s + off, n - off));
+}
+
+/* return True if string is entirely valid UTF-8 */
+static Eevo
+prim_strvalidp(EevoSt st, EevoRec env, Eevo args)
+{
+	char *s;
+	size_t n, i, end;
+	int len;
+	eevo_arg_num(args, "str-valid?", 1);
+	eevo_arg_type(fst(args), "str-valid?", EEVO_CHARS);
+	s = text_chars(fst(args)), n = text_len(fst(args));
+	if (fst(args)->t & EEVO_TEXT && fst(args)->v.str.utf8 == &utf8_ascii)
+		return True;
+	for (i = 0; i < n; ) { /* blocks of ASCII are skipped, others checked by character */
+		end = n - i < 256 ? n : i + 256;
+		if (utf8_isascii(s + i, end - i)) {
+			i = end;
+			continue;
+		}
+		for (; i < end; i += len) /* last character can run past end of block */
+			if (!(len = utf8_size(s + i, n - i)))
+				return Nil;
+	}
+	return True;
+}
+
+/* list of code points of UTF-8 characters in string, invalid bytes are U+FFFD */
+static Eevo
+prim_strcodes(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret = eevo_pair(NULL, Nil), pos = ret;
+	char *s;
+	size_t n, i;
+	int len;
+	eevo_arg_num(args, "str-codes", 1);
+	eevo_arg_type(fst(args), "str-codes", EEVO_CHARS);
+	s = text_chars(fst(args)), n = text_len(fst(args));
+	for (i = 0; i < n; i += len ? len : 1)
+		pos = rst(pos) = eevo_pair(eevo_int((len = utf8_size(s + i, n - i)) ?
+		                                     utf8_decode(s + i, len) : 0xFFFD), Nil);
+	return rst(ret);
+}
+
+/* create string of UTF-8 characters from list or vector of code points */
+static Eevo
+prim_strfromcodes(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo seq, v;
+	char *ret;
+	size_t n = 0;
+	int i = 0, len;
+	eevo_arg_num(args, "str-from-codes", 1);
+	eevo_arg_type(fst(args), "str-from-codes", EEVO_LIST | EEVO_VEC | EEVO_PVEC);
+	for (seq = fst(args); seq_next(&seq, &i, &v); n++)
+		eevo_arg_type(v, "str-from-codes", EEVO_INT);
+	if (!(ret = malloc(4 * n + 1)))
+		perror("; malloc"), exit(1);
+	for (i = n = 0, seq = fst(args); seq_next(&seq, &i, &v); n += len)
+		if (!(len = utf8_encode(ret + n, num(v)))) {
+			free(ret);
+			eevo_warnf("str-from-codes: invalid code point %d", (int)num(v));
+		}
+	ret[n] = '\0';
+	return str_new(ret);
+}
+
+/* convert ASCII letters of string to upper or lower case */
+#define PRIM_STRCASE(NAME, FN)                                     \
+static Eevo                                                        \
+prim_str##NAME(EevoSt st, EevoRec env, Eevo args)                  \
+{                                                                  \
+	Eevo ret;                                                  \
+	eevo_arg_num(args, "str-" #NAME, 1);                       \
+	eevo_arg_type(fst(args), "str-" #NAME, EEVO_CHARS);        \
+	ret = str_sub(text_chars(fst(args)), text_len(fst(args))); \
+	for (char *p = ret->v.s; *p; p++)                          \
+		*p = FN((unsigned char)*p);                        \
+	return ret;                                                \
+}
+
+PRIM_STRCASE(upper, toupper)
+PRIM_STRCASE(lower, tolower)
+
+/* join format string split by read_strfmt into literal strings and lists of
+ * expressions found inside curly braces, evaluating the expressions
+ * only reachable from f-strings, which the reader splits beforehand */
+static Eevo
+form_fstr(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo v;
+	char **strs, *ret, *pos;
+	int i, n = eevo_lstlen(args), len = 0;
+	if (!(strs = calloc(n, sizeof(char*))))
+		perror("; calloc"), exit(1);
+	for (i = 0, v = args; i < n; i++, v = rst(v)) {
+		if (fst(v)->t == EEVO_STR) {
+			strs[i] = fst(v)->v.s;
+		} else { /* TODO sandboxed eval, no mutable procs */
+			Eevo ev;
+			if (!(ev = eevo_eval_list(st, env, fst(v))) || !(strs[i] = eevo_print(ev)))
+				goto fail;
 			/* TODO if last = !d run display converter on it */
-			l = strlen(s);
-			ret_len += l;
-
-			if (ret_len >= ret_cap) /* resize output if necessary */
-				if (!(ret = realloc(ret, ret_cap *= 2)))
-					perror("; realloc"), exit(1);
-			memcpy(ret + pos, s, l);
-			free(s);
-			pos += l;
-		} else {
-			if (*str == '{' || *str == '}') str++; /* only add 1 curly brace when escaped */
-			ret[pos++] = *str++;
 		}
-	ret[pos] = '\0';
-	return eevo_str(st, ret);
+		len += strlen(strs[i]);
+	}
+
+	/* fill output once all lengths are known */
+	if (!(ret = malloc(len + 1)))
+		perror("; malloc"), exit(1);
+	for (i = 0, v = args, pos = ret; i < n; i++, v = rst(v)) {
+		int l = strlen(strs[i]);
+		memcpy(pos, strs[i], l);
+		pos += l;
+		if (fst(v)->t != EEVO_STR)
+			free(strs[i]);
+	}
+	*pos = '\0';
+	free(strs);
+	return str_new(ret);
+fail:
+	for (n = 0, v = args; n < i; n++, v = rst(v))
+		if (fst(v)->t != EEVO_STR)
+			free(strs[n]);
+	free(strs);
+	return NULL;
+}
+
+/* perform interpolation on explicit string, evaluating anything inside curly braces */
+/* FIXME nested strings shouldn't need to be escaped*/
+static Eevo
+form_strfmt(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "strfmt", 1);
+	eevo_arg_type(fst(args), "strfmt", EEVO_STR);
+	if (!(args = read_strfmt(st, fst(args)->v.s)) || args->t == EEVO_STR)
+		return args;
+	return form_fstr(st, env, args);
 }
 
 void
@@ -107,6 +682,28 @@ eevo_env_string(EevoSt st)
 {
 	st->types[5]->v.t.func = eevo_prim(EEVO_PRIM, prim_Str, "Str");
 	st->types[6]->v.t.func = eevo_prim(EEVO_PRIM, prim_Sym, "Sym");
+	st->types[21]->v.t.func = eevo_prim(EEVO_PRIM, prim_StrBuf, "StrBuf");
+	st->types[22]->v.t.func = eevo_prim(EEVO_PRIM, prim_Rope, "Rope");
+	st->types[23]->v.t.func = eevo_prim(EEVO_PRIM, prim_strslice, "StrView");
 	eevo_env_prim(strlen);
+	eevo_env_name_prim(strbuf-add!,   strbufadd);
+	eevo_env_name_prim(strbuf-clear!, strbufclear);
+	eevo_env_name_prim(str-slice,     strslice);
+	eevo_env_name_prim(str-find,      strfind);
+	eevo_env_name_prim(str-contains?, strcontainsp);
+	eevo_env_name_prim(str-prefix?,   strprefixp);
+	eevo_env_name_prim(str-suffix?,   strsuffixp);
+	eevo_env_name_prim(str-split,     strsplit);
+	eevo_env_name_prim(str-join,      strjoin);
+	eevo_env_name_prim(str-replace,   strreplace);
+	eevo_env_name_prim(str-trim,      strtrim);
+	eevo_env_name_prim(str-upper,     strupper);
+	eevo_env_name_prim(str-lower,     strlower);
+	eevo_env_name_prim(str-length,    strlength);
+	eevo_env_prim(substr);
+	eevo_env_name_prim(char-at,       charat);
+	eevo_env_name_prim(str-valid?,    strvalidp);
+	eevo_env_name_prim(str-codes,     strcodes);
+	eevo_env_name_prim(str-from-codes, strfromcodes);
 	eevo_env_form(strfmt);
 }
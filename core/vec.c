@@ -0,0 +1,187 @@
+/* zlib License
+ *
+ * Copyright (c) 2017-2025 Ed van Bruggen
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/* set IDX to index I of vector with length LEN, counting from end if negative */
+#define VEC_INDEX(NAME, I, IDX, LEN) do {                                        \
+	eevo_arg_type(I, NAME, EEVO_INT);                                        \
+	IDX = num(I) < 0 ? LEN + num(I) : num(I);                                \
+	if (IDX < 0 || IDX >= LEN)                                               \
+		eevo_warnf(NAME ": index %d out of bounds for vector of length %d", \
+		           (int)num(I), LEN);                                    \
+} while(0)
+
+/* create new vector from given values */
+static Eevo
+prim_Vec(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret = eevo_vec(abs(eevo_lstlen(args)));
+	for (; args->t == EEVO_PAIR; args = rst(args))
+		vec_push(ret, fst(args));
+	return ret;
+}
+
+/* return element of vector at index */
+static Eevo
+prim_vecref(EevoSt st, EevoRec env, Eevo args)
+{
+	int i;
+	eevo_arg_num(args, "vec-ref", 2);
+	eevo_arg_type(fst(args), "vec-ref", EEVO_VEC);
+	VEC_INDEX("vec-ref", snd(args), i, fst(args)->v.vec.len);
+	return fst(args)->v.vec.items[i];
+}
+
+/* replace element of vector at index */
+static Eevo
+prim_vecset(EevoSt st, EevoRec env, Eevo args)
+{
+	int i;
+	eevo_arg_num(args, "vec-set!", 3);
+	eevo_arg_type(fst(args), "vec-set!", EEVO_VEC);
+	VEC_INDEX("vec-set!", snd(args), i, fst(args)->v.vec.len);
+	fst(args)->v.vec.items[i] = fst(rrst(args));
+	return Void;
+}
+
+/* add values to end of vector */
+static Eevo
+prim_vecpush(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo vec;
+	eevo_arg_min(args, "vec-push!", 1);
+	vec = fst(args);
+	eevo_arg_type(vec, "vec-push!", EEVO_VEC);
+	for (args = rst(args); args->t == EEVO_PAIR; args = rst(args))
+		vec_push(vec, fst(args));
+	return Void;
+}
+
+/* return number of elements in vector */
+static Eevo
+prim_veclen(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "vec-len", 1);
+	eevo_arg_type(fst(args), "vec-len", EEVO_VEC);
+	return eevo_int(fst(args)->v.vec.len);
+}
+
+/* return list of elements in vector */
+static Eevo
+prim_veclist(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo vec, ret = Nil;
+	eevo_arg_num(args, "vec-list", 1);
+	vec = fst(args);
+	eevo_arg_type(vec, "vec-list", EEVO_VEC);
+	for (int i = vec->v.vec.len - 1; i >= 0; i--)
+		ret = eevo_pair(vec->v.vec.items[i], ret);
+	return ret;
+}
+
+/* create new persistent vector from given values */
+static Eevo
+prim_PVec(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret = eevo_pvec();
+	for (; args->t == EEVO_PAIR; args = rst(args))
+		pvec_conj(ret, fst(args), 0);
+	return ret;
+}
+
+/* return element of persistent vector at index */
+static Eevo
+prim_pvecnth(EevoSt st, EevoRec env, Eevo args)
+{
+	int i;
+	eevo_arg_num(args, "pvec-nth", 2);
+	eevo_arg_type(fst(args), "pvec-nth", EEVO_PVEC);
+	VEC_INDEX("pvec-nth", snd(args), i, fst(args)->v.pv.len);
+	return pvec_nth(fst(args), i);
+}
+
+/* return new persistent vector with element at index replaced,
+ * or added to the end if index is the length */
+static Eevo
+prim_pvecassoc(EevoSt st, EevoRec env, Eevo args)
+{
+	int i, len;
+	eevo_arg_num(args, "pvec-assoc", 3);
+	eevo_arg_type(fst(args), "pvec-assoc", EEVO_PVEC);
+	len = fst(args)->v.pv.len;
+	if (snd(args)->t == EEVO_INT && num(snd(args)) == len) /* add to end */
+		i = len;
+	else
+		VEC_INDEX("pvec-assoc", snd(args), i, len);
+	return pvec_assoc(fst(args), i, fst(rrst(args)));
+}
+
+/* return new persistent vector with values added to the end */
+static Eevo
+prim_pvecconj(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo ret;
+	eevo_arg_min(args, "pvec-conj", 1);
+	ret = fst(args);
+	eevo_arg_type(ret, "pvec-conj", EEVO_PVEC);
+	for (args = rst(args); args->t == EEVO_PAIR; args = rst(args))
+		ret = pvec_conj(ret, fst(args), 1);
+	return ret;
+}
+
+/* return number of elements in persistent vector */
+static Eevo
+prim_pveclen(EevoSt st, EevoRec env, Eevo args)
+{
+	eevo_arg_num(args, "pvec-len", 1);
+	eevo_arg_type(fst(args), "pvec-len", EEVO_PVEC);
+	return eevo_int(fst(args)->v.pv.len);
+}
+
+/* return list of elements in persistent vector */
+static Eevo
+prim_pveclist(EevoSt st, EevoRec env, Eevo args)
+{
+	Eevo pv, ret = Nil;
+	eevo_arg_num(args, "pvec-list", 1);
+	pv = fst(args);
+	eevo_arg_type(pv, "pvec-list", EEVO_PVEC);
+	for (int i = pv->v.pv.len - 1; i >= 0; i--)
+		ret = eevo_pair(pvec_nth(pv, i), ret);
+	return ret;
+}
+
+void
+eevo_env_vec(EevoSt st)
+{
+	st->types[15]->v.t.func = eevo_prim(EEVO_PRIM, prim_Vec, "Vec");
+	eevo_env_name_prim(vec-ref,   vecref);
+	eevo_env_name_prim(vec-set!,  vecset);
+	eevo_env_name_prim(vec-push!, vecpush);
+	eevo_env_name_prim(vec-len,   veclen);
+	eevo_env_name_prim(vec-list,  veclist);
+
+	st->types[16]->v.t.func = eevo_prim(EEVO_PRIM, prim_PVec, "PVec");
+	eevo_env_name_prim(pvec-nth,   pvecnth);
+	eevo_env_name_prim(pvec-assoc, pvecassoc);
+	eevo_env_name_prim(pvec-conj,  pvecconj);
+	eevo_env_name_prim(pvec-len,   pveclen);
+	eevo_env_name_prim(pvec-list,  pveclist);
+}
@@ -19,6 +19,7 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 #include <ctype.h>
+#include <limits.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -28,7 +29,7 @@
 #include "eevo.h"
 
 struct Eevo_ eevo_nil  = { .t = EEVO_NIL };
-struct Eevo_ eevo_true = { .t = EEVO_SYM, .v = { .s = "True" } };
+struct Eevo_ eevo_true = { .t = EEVO_SYM, .v = { .str = { "True", NULL } } };
 struct Eevo_ eevo_void = { .t = EEVO_VOID };
 
 #define Nil &eevo_nil
@@ -51,6 +52,13 @@ struct Eevo_ eevo_void = { .t = EEVO_VOID };
 /* functions */
 static void rec_add(EevoRec rec, char *key, Eevo val);
 static Eevo eval_proc(EevoSt st, EevoRec env, Eevo f, Eevo args);
+static Eevo eval_apply(EevoSt st, EevoRec env, Eevo f, Eevo args);
+static Eevo form_cond(EevoSt st, EevoRec env, Eevo args);
+static Eevo form_fstr(EevoSt st, EevoRec env, Eevo args);
+static Eevo pvec_nth(Eevo pv, int i);
+static Eevo map_get(EevoMap m, Eevo key);
+static Eevo numfn_call(Eevo f, Eevo args);
+static char *rope_flat(Eevo v);
 
 /* utility functions */
 
@@ -85,10 +93,22 @@ eevo_type_str(EevoType t)
 	case EEVO_PAIR:  return "Pair";
 	case EEVO_REC:   return "Rec";
 	case EEVO_TYPE:  return "Type";
+	case EEVO_GEN:   return "Generic";
+	case EEVO_VEC:   return "Vec";
+	case EEVO_PVEC:  return "PVec";
+	case EEVO_MAP:   return "Map";
+	case EEVO_SET:   return "Set";
+	case EEVO_NUMARR: return "NumArray";
+	case EEVO_NUMFN:  return "NumFunc";
+	case EEVO_STRBUF: return "StrBuf";
+	case EEVO_ROPE:   return "Rope";
+	case EEVO_STRVIEW: return "StrView";
+	case EEVO_REGEX:  return "Regex";
 	case EEVO_RATIONAL: return "Rational";
 	case EEVO_NUM:      return "Num";
 	case EEVO_EXPR:     return "Expr";
 	case EEVO_TEXT:     return "Text";
+	case EEVO_CHARS:    return "Chars";
 	case EEVO_PROC:     return "Proc";
 	case EEVO_LIT:      return "Lit";
 	case EEVO_LIST:     return "List";
@@ -104,9 +124,9 @@ eevo_type_str(EevoType t)
 static int
 is_sym(char c)
 {
-	/* TODO expand for all UTF: if c > 255 */
+	/* bytes of UTF-8 characters outside of ASCII are all part of symbols */
 	return BETWEEN(c, 'a', 'z') || BETWEEN(c, 'A', 'Z') ||
-	       BETWEEN(c, '0', '9') || strchr(EEVO_SYM_CHARS, c);
+	       BETWEEN(c, '0', '9') || (unsigned char)c >= 0x80 || strchr(EEVO_SYM_CHARS, c);
 }
 
 /* check if character can be a part of an operator */
@@ -153,6 +173,30 @@ eevo_lstlen(Eevo v)
 	return nilp(v) ? len : -(len + 1);
 }
 
+/* length of string, symbol, string buffer, rope or string view */
+static size_t
+text_len(Eevo v)
+{
+	switch (v->t) {
+	case EEVO_ROPE:    return v->v.rope->len;
+	case EEVO_STRBUF:  return v->v.sb.len;
+	case EEVO_STRVIEW: return v->v.sv.len;
+	default:           return strlen(v->v.s);
+	}
+}
+
+/* start of characters of text, string views are not NUL terminated */
+static char *
+text_chars(Eevo v)
+{
+	switch (v->t) {
+	case EEVO_ROPE:    return rope_flat(v);
+	case EEVO_STRBUF:  return v->v.sb.s;
+	case EEVO_STRVIEW: return v->v.sv.s;
+	default:           return v->v.s;
+	}
+}
+
 /* check if two values are equal */
 static int
 vals_eq(Eevo a, Eevo b)
@@ -162,15 +206,55 @@ vals_eq(Eevo a, Eevo b)
 			return 0;
 		return 1;
 	}
+	if (a->t & EEVO_STRS && b->t & EEVO_STRS) /* STRING, VIEW, BUFFER, ROPE */
+		return a == b || (text_len(a) == text_len(b) &&
+		                  !memcmp(text_chars(a), text_chars(b), text_len(a)));
 	if (a->t != b->t)
 		return 0;
-	if (a->t == EEVO_PAIR) /* PAIR */
-		return vals_eq(fst(a), fst(b)) && vals_eq(rst(a), rst(b));
+	if (a->t == EEVO_PAIR) /* PAIR, shared structure is equal without walking it */
+		return a == b || (vals_eq(fst(a), fst(b)) && vals_eq(rst(a), rst(b)));
 	/* TODO function var names should not matter in comparison */
 	if (a->t & (EEVO_FUNC | EEVO_MACRO)) /* FUNCTION, MACRO */
 		return vals_eq(a->v.f.args, b->v.f.args) &&
 		       vals_eq(a->v.f.body, b->v.f.body);
-	if (a != b) /* PRIMITIVE, STRING, SYMBOL, NIL, VOID */
+	if (a->t == EEVO_VEC) { /* VECTOR */
+		if (a->v.vec.len != b->v.vec.len)
+			return 0;
+		for (int i = 0; i < a->v.vec.len; i++)
+			if (!vals_eq(a->v.vec.items[i], b->v.vec.items[i]))
+				return 0;
+		return 1;
+	}
+	if (a->t == EEVO_PVEC) { /* PERSISTENT VECTOR */
+		if (a->v.pv.len != b->v.pv.len)
+			return 0;
+		for (int i = 0; i < a->v.pv.len; i++)
+			if (!vals_eq(pvec_nth(a, i), pvec_nth(b, i)))
+				return 0;
+		return 1;
+	}
+	if (a->t == EEVO_NUMARR) { /* NUMBER ARRAY */
+		if (a->v.na.len != b->v.na.len)
+			return 0;
+		for (int i = 0; i < a->v.na.len; i++)
+			if (a->v.na.d[i] != b->v.na.d[i])
+				return 0;
+		return 1;
+	}
+	if (a->t == EEVO_REGEX) /* REGEX */
+		return a == b || !strcmp(a->v.re->pat, b->v.re->pat);
+	if (a->t & (EEVO_MAP | EEVO_SET)) { /* MAP, SET */
+		Eevo v;
+		if (a->v.m->size != b->v.m->size)
+			return 0;
+		for (int i = 0; i < a->v.m->used; i++)
+			if (a->v.m->items[i].key &&
+			    (!(v = map_get(b->v.m, a->v.m->items[i].key)) ||
+			     !vals_eq(a->v.m->items[i].val, v)))
+				return 0;
+		return 1;
+	}
+	if (a != b) /* PRIMITIVE, SYMBOL, NIL, VOID */
 		return 0;
 	return 1;
 }
@@ -202,35 +286,269 @@ hash(char *key)
 	return h;
 }
 
-/* create new empty rec with given capacity */
+/* return same hash as hash() for first n characters of key */
+static uint32_t
+hash_n(char *key, size_t n)
+{
+	uint32_t h = 0;
+	for (; n && h < UINT32_MAX; n--)
+		h = h * 33 + *key++;
+	return h;
+}
+
+/* allocate record without any storage for entries */
 static EevoRec
-rec_new(size_t cap, EevoRec next)
+rec_alloc(EevoRec next)
 {
 	EevoRec rec;
 	if (!(rec = malloc(sizeof(struct EevoRec_))))
 		perror("; malloc"), exit(1);
 	rec->size = 0;
+	rec->cap = 0;
+	rec->linear = 0;
+	rec->escaped = 0;
+	rec->loop = 0;
+	rec->items = NULL;
+	rec->index = NULL;
+	rec->root = NULL;
+	rec->shape = NULL;
+	rec->body = NULL;
+	rec->next = next;
+	return rec;
+}
+
+/* create new empty rec with given capacity of its index, entries are only
+ * allocated for the part of the index that can be filled before it grows */
+static EevoRec
+rec_new(size_t cap, EevoRec next)
+{
+	EevoRec rec = rec_alloc(next);
 	rec->cap = cap;
-	if (!(rec->items = calloc(cap, sizeof(struct EevoEntry_))))
+	if (!(rec->items = calloc(cap / EEVO_REC_FACTOR + 1, sizeof(struct EevoEntry_))) ||
+	    !(rec->index = calloc(cap, sizeof(int))))
 		perror("; calloc"), exit(1);
-	rec->next = next;
 	return rec;
 }
 
-/* get entry in one record for the key */
-static EevoEntry
-entry_get(EevoRec rec, char *key)
+/* create new rec without an index, faster than hashing for the few variables
+ * held by most call frames and small records */
+static EevoRec
+rec_new_linear(EevoRec next)
 {
-	int i = hash(key) % rec->cap;
+	EevoRec rec = rec_alloc(next);
+	rec->cap = EEVO_FRAME_CAP + 1; /* room for entry_get to clear past last key */
+	rec->linear = 1;
+	if (!(rec->items = calloc(EEVO_FRAME_CAP + 1, sizeof(struct EevoEntry_))))
+		perror("; calloc"), exit(1);
+	return rec;
+}
+
+/* get slot of index which holds the entry for key, or empty one to be filled */
+static int *
+index_get(EevoRec rec, char *key)
+{
+	int *p, i = hash(key) % rec->cap;
 	char *s;
-	/* look for key starting at hash until empty entry is found */
-	while ((s = rec->items[i].key)) {
-		if (!strcmp(s, key))
+	/* look for key starting at hash until empty slot is found */
+	while (*(p = &rec->index[i])) {
+		if ((s = rec->items[*p - 1].key) == key || !strcmp(s, key))
 			break;
 		if (++i == rec->cap) /* loop back around if end is reached */
 			i = 0;
 	}
-	return &rec->items[i]; /* returns entry if found or empty one to be filled */
+	return p;
+}
+
+/* get entry in one record for the key */
+static EevoEntry
+entry_get(EevoRec rec, char *key)
+{
+	int i;
+	char *s;
+	if (rec->linear) { /* keys are usually interned symbols, compare pointers first */
+		for (i = 0; i < rec->size; i++)
+			if ((s = rec->items[i].key) && (s == key || (*s == *key && !strcmp(s, key))))
+				return &rec->items[i];
+		rec->items[i].key = NULL; /* could be left over from reused frame */
+		return &rec->items[i];
+	}
+	if ((i = *index_get(rec, key)))
+		return &rec->items[i - 1];
+	rec->items[rec->size].key = NULL;
+	return &rec->items[rec->size]; /* empty entry to be filled */
+}
+
+#define TRIE_MASK ((1 << EEVO_TRIE_BITS) - 1)
+
+/* number of bits set */
+static int
+bitcount(uint32_t x)
+{
+	x = x - ((x >> 1) & 0x55555555);
+	x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+	return (((x + (x >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
+
+/* create trie node with room for len slots */
+static EevoNode
+node_new(uint32_t map, int len)
+{
+	EevoNode n;
+	if (!(n = malloc(sizeof(struct EevoNode_) + len * sizeof(struct EevoSlot_))))
+		perror("; malloc"), exit(1);
+	n->map = map;
+	n->len = len;
+	return n;
+}
+
+/* copy node so it can be changed without affecting records sharing it */
+static EevoNode
+node_copy(EevoNode n)
+{
+	EevoNode ret = node_new(n->map, n->len);
+	memcpy(ret->slots, n->slots, n->len * sizeof(struct EevoSlot_));
+	return ret;
+}
+
+/* create empty record stored as persistent hash trie */
+static EevoRec
+rec_new_trie(void)
+{
+	EevoRec rec = rec_alloc(NULL);
+	rec->root = node_new(0, 0);
+	return rec;
+}
+
+/* get entry for key in trie or NULL if it is not found
+ *   each level uses the next bits of the hash to pick its slot, once all bits are
+ *   used the node holds every colliding entry */
+static EevoEntry
+trie_get(EevoNode n, char *key, uint32_t h)
+{
+	uint32_t bit;
+	struct EevoSlot_ *s;
+	for (int shift = 0; ; shift += EEVO_TRIE_BITS) {
+		if (shift >= 32) {
+			for (int i = 0; i < n->len; i++)
+				if (n->slots[i].e.key == key || !strcmp(n->slots[i].e.key, key))
+					return &n->slots[i].e;
+			return NULL;
+		}
+		bit = 1u << (h >> shift & TRIE_MASK);
+		if (!(n->map & bit))
+			return NULL;
+		s = &n->slots[bitcount(n->map & (bit - 1))];
+		if (s->e.key)
+			return s->e.key == key || !strcmp(s->e.key, key) ? &s->e : NULL;
+		n = s->sub;
+	}
+}
+
+/* create node holding two entries whose hashes match up to given shift */
+static EevoNode
+trie_pair(struct EevoEntry_ a, uint32_t ha, struct EevoEntry_ b, uint32_t hb, int shift)
+{
+	EevoNode n;
+	uint32_t fa, fb;
+	if (shift >= 32) {
+		n = node_new(0, 2);
+		n->slots[0].e = a, n->slots[1].e = b;
+		return n;
+	}
+	fa = ha >> shift & TRIE_MASK, fb = hb >> shift & TRIE_MASK;
+	if (fa == fb) {
+		n = node_new(1u << fa, 1);
+		n->slots[0].e.key = NULL;
+		n->slots[0].sub = trie_pair(a, ha, b, hb, shift + EEVO_TRIE_BITS);
+		return n;
+	}
+	n = node_new(1u << fa | 1u << fb, 2);
+	n->slots[fa > fb].e = a, n->slots[fa > fb].sub = NULL;
+	n->slots[fa < fb].e = b, n->slots[fa < fb].sub = NULL;
+	return n;
+}
+
+/* return trie with entry added or replaced, setting added if the key is new
+ *   if copy is set nodes along the path are copied leaving the original trie
+ *   intact, otherwise it is changed in place */
+static EevoNode
+trie_put(EevoNode n, struct EevoEntry_ e, uint32_t h, int shift, int copy, int *added)
+{
+	int i;
+	uint32_t bit = 0;
+	EevoNode ret;
+	struct EevoSlot_ *s;
+	if (shift >= 32) { /* hash fully collides, search every entry */
+		for (i = 0; i < n->len; i++)
+			if (!strcmp(n->slots[i].e.key, e.key))
+				break;
+	} else {
+		bit = 1u << (h >> shift & TRIE_MASK);
+		i = bitcount(n->map & (bit - 1));
+	}
+	if (bit ? n->map & bit : i < n->len) {
+		ret = copy ? node_copy(n) : n;
+		s = &ret->slots[i];
+		if (!s->e.key) {
+			s->sub = trie_put(s->sub, e, h, shift + EEVO_TRIE_BITS, copy, added);
+		} else if (!strcmp(s->e.key, e.key)) {
+			s->e.val = e.val;
+		} else { /* different key in slot, move both down a level */
+			s->sub = trie_pair(s->e, hash(s->e.key), e, h, shift + EEVO_TRIE_BITS);
+			s->e.key = NULL;
+			*added = 1;
+		}
+		return ret;
+	}
+	ret = node_new(n->map | bit, n->len + 1);
+	memcpy(ret->slots, n->slots, i * sizeof(struct EevoSlot_));
+	memcpy(ret->slots + i + 1, n->slots + i, (n->len - i) * sizeof(struct EevoSlot_));
+	ret->slots[i].e = e;
+	ret->slots[i].sub = NULL;
+	if (!copy)
+		free(n);
+	*added = 1;
+	return ret;
+}
+
+/* store pointer to each entry of trie in ents, returning number stored */
+static int
+trie_entries(EevoNode n, EevoEntry *ents)
+{
+	int c = 0;
+	for (int i = 0; i < n->len; i++)
+		if (n->slots[i].e.key)
+			ents[c++] = &n->slots[i].e;
+		else
+			c += trie_entries(n->slots[i].sub, ents + c);
+	return c;
+}
+
+/* return array of pointers to the rec->size entries of a single record
+ *   returned array needs to be freed after use */
+static EevoEntry *
+rec_entries(EevoRec rec)
+{
+	EevoEntry *ents;
+	if (!(ents = malloc((rec->size + 1) * sizeof(EevoEntry))))
+		perror("; malloc"), exit(1);
+	if (rec->root)
+		trie_entries(rec->root, ents);
+	else
+		for (int i = 0; i < rec->size; i++)
+			ents[i] = &rec->items[i];
+	return ents;
+}
+
+/* return new record with key set to val, sharing rest of trie with rec */
+static EevoRec
+rec_assoc(EevoRec rec, char *key, Eevo val)
+{
+	int added = 0;
+	EevoRec ret = rec_alloc(NULL);
+	ret->root = trie_put(rec->root, (struct EevoEntry_){ key, val }, hash(key), 0, 1, &added);
+	ret->size = rec->size + added;
+	return ret;
 }
 
 /* get value of given key in each record */
@@ -239,6 +557,11 @@ rec_get(EevoRec rec, char *key)
 {
 	EevoEntry e;
 	for (; rec; rec = rec->next) {
+		if (rec->root) {
+			if ((e = trie_get(rec->root, key, hash(key))))
+				return e->val;
+			continue;
+		}
 		e = entry_get(rec, key);
 		if (e->key)
 			return e->val;
@@ -246,43 +569,190 @@ rec_get(EevoRec rec, char *key)
 	return NULL;
 }
 
-/* enlarge the record to ensure algorithm's efficiency */
+/* fill empty index with position of each entry, entries stay in order */
+static void
+rec_reindex(EevoRec rec)
+{
+	int i, j;
+	for (i = 0; i < rec->size; i++) {
+		j = hash(rec->items[i].key) % rec->cap;
+		while (rec->index[j])
+			j = (j + 1) % rec->cap;
+		rec->index[j] = i + 1;
+	}
+}
+
+/* enlarge the record to ensure algorithm's efficiency, linear records are
+ * given an index with room to grow */
 static void
 rec_grow(EevoRec rec)
 {
-	int i, ocap = rec->cap;
-	EevoEntry oitems = rec->items;
-	rec->cap *= EEVO_REC_FACTOR;
-	if (!(rec->items = calloc(rec->cap, sizeof(struct EevoEntry_))))
-		perror("; calloc"), exit(1);
-	for (i = 0; i < ocap; i++) /* repopulate new record with old values */
-		if (oitems[i].key)
-			rec_add(rec, oitems[i].key, oitems[i].val);
-	free(oitems);
+	rec->cap *= rec->linear ? EEVO_REC_FACTOR * EEVO_REC_FACTOR : EEVO_REC_FACTOR;
+	rec->linear = 0;
+	free(rec->index);
+	if (!(rec->items = realloc(rec->items, (rec->cap / EEVO_REC_FACTOR + 1) *
+	                                       sizeof(struct EevoEntry_))) ||
+	    !(rec->index = calloc(rec->cap, sizeof(int))))
+		perror("; malloc"), exit(1);
+	rec_reindex(rec);
 }
 
 /* create new key and value pair to the record */
 static void
 rec_add(EevoRec rec, char *key, Eevo val)
 {
-	EevoEntry e = entry_get(rec, key);
+	EevoEntry e;
+	int added = 0, *slot = NULL;
+	if (rec->root) { /* record is not shared yet, change trie in place */
+		rec->root = trie_put(rec->root, (struct EevoEntry_){ key, val }, hash(key), 0, 0, &added);
+		rec->size += added;
+		return;
+	}
+	if (rec->linear)
+		e = entry_get(rec, key);
+	else if (*(slot = index_get(rec, key)))
+		e = &rec->items[*slot - 1];
+	else
+		e = &rec->items[rec->size], e->key = NULL;
 	e->val = val;
 	if (!e->key) {
 		e->key = key;
-		/* grow record if it is more than half full */
-		if (++rec->size > rec->cap / EEVO_REC_FACTOR)
+		rec->shape = NULL; /* keys no longer match its shape */
+		if (slot)
+			*slot = rec->size + 1;
+		/* grow record if it is more than half full, or linear one is full */
+		if (++rec->size > rec->cap / EEVO_REC_FACTOR &&
+		    (!rec->linear || rec->size == rec->cap))
 			rec_grow(rec);
 	}
 }
 
-/* add each vals[i] to rec with key args[i] */
+/* remove key from record, packing the entries after it so they stay in order,
+ * returns 0 if the record does not hold key */
+static int
+rec_del(EevoRec rec, char *key)
+{
+	int i, *slot;
+	if (rec->root) /* record values are never changed */
+		return 0;
+	if (rec->linear) {
+		EevoEntry e = entry_get(rec, key);
+		if (!e->key)
+			return 0;
+		i = e - rec->items;
+	} else if (!*(slot = index_get(rec, key))) {
+		return 0;
+	} else {
+		i = *slot - 1;
+	}
+	memmove(&rec->items[i], &rec->items[i + 1], (rec->size - i - 1) * sizeof(struct EevoEntry_));
+	rec->size--;
+	rec->shape = NULL;
+	if (!rec->linear) { /* positions after key changed, rebuild index */
+		memset(rec->index, 0, rec->cap * sizeof(int));
+		rec_reindex(rec);
+	}
+	return 1;
+}
+
+/* get shape made by adding key to shape, creating it the first time */
+static EevoShape
+shape_add(EevoShape shape, char *key)
+{
+	EevoShape s;
+	for (s = shape->kids; s; s = s->next)
+		if (s->key == key || !strcmp(s->key, key))
+			return s;
+	if (!(s = malloc(sizeof(struct EevoShape_))))
+		perror("; malloc"), exit(1);
+	s->key = key;
+	s->kids = NULL;
+	s->next = shape->kids;
+	return shape->kids = s;
+}
+
+/* give finished small record the shape of its keys, so records built with the
+ * same keys can share the position of each key found by property access */
+static void
+rec_shape(EevoSt st, EevoRec rec)
+{
+	EevoShape shape = st->shapes;
+	if (rec->root || rec->next)
+		return;
+	for (int i = 0; i < rec->size; i++)
+		shape = shape_add(shape, rec->items[i].key);
+	rec->shape = shape;
+}
+
+/* get value of key in record for access site rec::key, or its else entry,
+ *   site remembers slot of key in last shape seen, so records of same shape
+ *   only need to compare their shape before loading the value */
+static Eevo
+rec_prop(EevoSt st, EevoRec rec, char *key, Eevo site)
+{
+	int i, slot = -1;
+	Eevo ret;
+	char *s;
+	struct EevoProp_ *p = &st->props[((uintptr_t)site >> 4) % EEVO_PROP_CACHE];
+	if (rec->shape && p->shape == rec->shape && p->key == key)
+		return rec->items[p->slot].val;
+	if (rec->shape) {
+		for (i = 0; i < rec->size; i++)
+			if ((s = rec->items[i].key) == key || !strcmp(s, key))
+				break;
+			else if (slot < 0 && !strcmp(s, "else"))
+				slot = i;
+		if (i < rec->size)
+			slot = i;
+		if (slot >= 0) {
+			p->shape = rec->shape, p->key = key, p->slot = slot;
+			return rec->items[slot].val;
+		}
+	} else if ((ret = rec_get(rec, key)) || (ret = rec_get(rec, "else")))
+		return ret;
+	eevo_warnf("could not find element '%s' in record", key);
+}
+
+/* key of tag given to break in frame of loop, not a valid symbol so it can not
+ * be shadowed, found lexically so break only exits loops it is written in */
+#define EEVO_LOOP_TAG "(break)"
+
+/* get empty linear call frame, reusing one that has returned if possible */
 static EevoRec
-rec_extend(EevoRec next, Eevo args, Eevo vals)
+frame_new(EevoSt st, EevoRec next)
+{
+	EevoRec rec = st->frames;
+	if (!rec)
+		return rec_new_linear(next);
+	st->frames = rec->next;
+	rec->size = 0;
+	rec->loop = 0;
+	rec->next = next;
+	return rec;
+}
+
+/* return call frame to be reused, unless a closure still refers to it */
+static void
+frame_release(EevoSt st, EevoRec rec)
+{
+	if (rec->escaped)
+		return;
+	if (!rec->linear) { /* too many arguments or grown by def into hash table */
+		free(rec->items);
+		free(rec->index);
+		free(rec);
+		return;
+	}
+	rec->next = st->frames;
+	st->frames = rec;
+}
+
+/* add each vals[i] to call frame with key args[i], returning first argument
+ * which is not a symbol or NULL if all are valid */
+static Eevo
+frame_fill(EevoRec rec, Eevo args, Eevo vals)
 {
 	Eevo arg, val;
-	int argnum = EEVO_REC_FACTOR * eevo_lstlen(args);
-	/* HACK need extra +1 for when argnum = 0 */
-	EevoRec ret = rec_new(argnum > 0 ? argnum : -argnum + 1, next);
 	for (; !nilp(args); args = rst(args), vals = rst(vals)) {
 		if (args->t == EEVO_PAIR) {
 			arg = fst(args);
@@ -292,13 +762,136 @@ rec_extend(EevoRec next, Eevo args, Eevo vals)
 			val = vals;
 		}
 		if (arg->t != EEVO_SYM)
-			eevo_warnf("expected symbol for argument of function definition, "
-			           "recieved '%s'",
-			          eevo_type_str(arg->t));
-		rec_add(ret, arg->v.s, val);
+			return arg;
+		if (rec->linear) /* place each argument at its position */
+			rec->items[rec->size].key = arg->v.s, rec->items[rec->size++].val = val;
+		else
+			rec_add(rec, arg->v.s, val);
 		if (args->t != EEVO_PAIR)
 			break;
 	}
+	return NULL;
+}
+
+/* add each vals[i] to new call frame of function f with key args[i] */
+static EevoRec
+rec_extend(EevoSt st, Eevo f, Eevo vals)
+{
+	Eevo arg, args = f->v.f.args;
+	int argnum = abs(eevo_lstlen(args)); /* negative for variadic functions */
+	EevoRec ret = argnum <= EEVO_FRAME_CAP ? frame_new(st, f->v.f.env)
+	                                      : rec_new(EEVO_REC_FACTOR * argnum + 1, f->v.f.env);
+	ret->body = f->v.f.body;
+	if ((arg = frame_fill(ret, args, vals))) {
+		frame_release(st, ret);
+		eevo_warnf("expected symbol for argument of function definition, "
+		           "recieved '%s'",
+		          eevo_type_str(arg->t));
+	}
+	return ret;
+}
+
+/* check if symbol is in list, symbols are interned so compare pointers */
+static int
+sym_memberp(Eevo sym, Eevo lst)
+{
+	for (; lst->t == EEVO_PAIR; lst = rst(lst))
+		if (fst(lst) == sym)
+			return 1;
+	return 0;
+}
+
+/* add each parameter symbol to list of bound symbols */
+static Eevo
+syms_params(Eevo params, Eevo bound)
+{
+	for (; params->t == EEVO_PAIR; params = rst(params))
+		bound = eevo_pair(fst(params), bound);
+	return params->t == EEVO_SYM ? eevo_pair(params, bound) : bound;
+}
+
+/* collect symbols used in v which are not bound by parameters into used, and
+ * symbols defined with def into defs */
+static void
+syms_free(EevoSt st, Eevo v, Eevo bound, Eevo *used, Eevo *defs)
+{
+	Eevo idefs = Nil;
+	if (v->t == EEVO_SYM) {
+		if (!sym_memberp(v, bound) && !sym_memberp(v, *used))
+			*used = eevo_pair(v, *used);
+		return;
+	}
+	if (v->t != EEVO_PAIR)
+		return;
+	if (fst(v)->t == EEVO_SYM && rst(v)->t == EEVO_PAIR) {
+		char *s = fst(v)->v.s;
+		if (!strcmp(s, "quote"))
+			return;
+		/* nested functions have their own parameters and definitions */
+		if (!strcmp(s, "Func") || !strcmp(s, "Macro")) {
+			if (nilp(rrst(v)))
+				syms_free(st, snd(v), eevo_pair(eevo_sym(st, "it"), bound), used, &idefs);
+			else
+				syms_free(st, rrst(v), syms_params(snd(v), bound), used, &idefs);
+			return;
+		}
+		if (!strcmp(s, "def") && snd(v)->t == EEVO_PAIR && fst(snd(v))->t == EEVO_SYM) {
+			*defs = eevo_pair(fst(snd(v)), *defs);
+			syms_free(st, rrst(v), syms_params(rst(snd(v)), bound), used, &idefs);
+			return;
+		}
+		if (!strcmp(s, "def") && snd(v)->t == EEVO_SYM)
+			*defs = eevo_pair(snd(v), *defs);
+	}
+	for (; v->t == EEVO_PAIR; v = rst(v))
+		syms_free(st, fst(v), bound, used, defs);
+	syms_free(st, v, bound, used, defs);
+}
+
+/* create environment for a new closure holding a copy of the local variables
+ * used in its body, so it does not keep every enclosing frame alive and globals
+ * are found after one lookup, falls back to the full environment if a used
+ * symbol is defined with def in the body of an enclosing function, or not
+ * defined yet, since it could still be added to or changed in one of the
+ * enclosing frames */
+static EevoRec
+closure_env(EevoSt st, EevoRec env, Eevo params, Eevo body, Eevo self)
+{
+	Eevo used = Nil, defs = Nil, vars = Nil, outer = Nil, unused = Nil, tag = NULL;
+	EevoRec r, ret;
+	EevoEntry e = NULL;
+	int n = 0;
+	if (env == st->env)
+		return env;
+	syms_free(st, body, syms_params(params, Nil), &used, &defs);
+	/* break in closure exits the loop it was created in */
+	if (sym_memberp(eevo_sym(st, "break"), used) && (tag = rec_get(env, EEVO_LOOP_TAG)))
+		n++;
+	for (r = env; r && r != st->env; r = r->next)
+		for (Eevo b = r->body ? r->body : Nil; b->t == EEVO_PAIR; b = rst(b))
+			syms_free(st, fst(b), Nil, &unused, &outer);
+	for (; used->t == EEVO_PAIR; used = rst(used)) {
+		if (fst(used) != self && sym_memberp(fst(used), outer))
+			break;
+		for (r = env; r && r != st->env; r = r->next)
+			if ((e = entry_get(r, fst(used)->v.s))->key)
+				break;
+		if (r && r != st->env)
+			vars = eevo_pair(eevo_pair(fst(used), e->val), vars), n++;
+		else if (fst(used) != self && !sym_memberp(fst(used), defs) &&
+		         !rec_get(st->env, fst(used)->v.s))
+			break;
+	}
+	if (used->t == EEVO_PAIR) { /* frames are kept by the closure, so they can not be reused */
+		for (r = env; r && r != st->env; r = r->next)
+			r->escaped = 1;
+		return env;
+	}
+	ret = n <= EEVO_FRAME_CAP ? rec_new_linear(st->env) : rec_new(EEVO_REC_FACTOR * n + 1, st->env);
+	for (; vars->t == EEVO_PAIR; vars = rst(vars))
+		rec_add(ret, ffst(vars)->v.s, rfst(vars));
+	if (tag)
+		rec_add(ret, EEVO_LOOP_TAG, tag);
 	return ret;
 }
 
@@ -370,11 +963,22 @@ eevo_str(EevoSt st, char *s)
 	if ((ret = rec_get(st->strs, s)))
 		return ret;
 	ret = eevo_val(EEVO_STR);
-	ret->v.s = s;
+	ret->v.str.s = s;
+	ret->v.str.utf8 = NULL;
 	rec_add(st->strs, s, ret);
 	return ret;
 }
 
+/* create string without interning it, used for strings built at run time */
+static Eevo
+str_new(char *s)
+{
+	Eevo ret = eevo_val(EEVO_STR);
+	ret->v.str.s = s;
+	ret->v.str.utf8 = NULL;
+	return ret;
+}
+
 Eevo
 eevo_sym(EevoSt st, char *s)
 {
@@ -382,7 +986,8 @@ eevo_sym(EevoSt st, char *s)
 	if ((ret = rec_get(st->syms, s)))
 		return ret;
 	ret = eevo_val(EEVO_SYM);
-	ret->v.s = s;
+	ret->v.str.s = s;
+	ret->v.str.utf8 = NULL;
 	rec_add(st->syms, s, ret);
 	return ret;
 }
@@ -407,17 +1012,493 @@ eevo_func(EevoType t, char *name, Eevo args, Eevo body, EevoRec env)
 	return ret;
 }
 
+Eevo
+eevo_gen(char *name, Eevo args)
+{
+	Eevo ret = eevo_val(EEVO_GEN);
+	if (!(ret->v.g = malloc(sizeof(struct EevoGen_))))
+		perror("; malloc"), exit(1);
+	ret->v.g->name = name;
+	ret->v.g->args = args;
+	ret->v.g->methods = Nil;
+	ret->v.g->version = 0;
+	return ret;
+}
+
+Eevo
+eevo_numfn(Eevo args, Eevo expr)
+{
+	Eevo ret = eevo_val(EEVO_NUMFN);
+	if (!(ret->v.nf = calloc(1, sizeof(struct EevoNumFn_))))
+		perror("; calloc"), exit(1);
+	ret->v.nf->args = args;
+	ret->v.nf->expr = expr;
+	ret->v.nf->argc = eevo_lstlen(args);
+	return ret;
+}
+
+Eevo
+eevo_vec(int cap)
+{
+	Eevo ret = eevo_val(EEVO_VEC);
+	ret->v.vec.len = 0;
+	ret->v.vec.cap = cap > 0 ? cap : 1;
+	if (!(ret->v.vec.items = malloc(ret->v.vec.cap * sizeof(Eevo))))
+		perror("; malloc"), exit(1);
+	return ret;
+}
+
+/* append value to end of vector, doubling its capacity when full */
+static void
+vec_push(Eevo vec, Eevo v)
+{
+	if (vec->v.vec.len == vec->v.vec.cap) {
+		vec->v.vec.cap *= 2;
+		if (!(vec->v.vec.items = realloc(vec->v.vec.items, vec->v.vec.cap * sizeof(Eevo))))
+			perror("; realloc"), exit(1);
+	}
+	vec->v.vec.items[vec->v.vec.len++] = v;
+}
+
+/* persistent vectors
+ * elements are stored in a trie of nodes with EEVO_PVEC_WIDTH children, with the
+ * last (up to) EEVO_PVEC_WIDTH elements kept in a separate tail node, so adding
+ * to the end usually only copies the tail instead of the path to the leaf
+ * nodes are never changed once the vector is given to eevo code, only copied */
+
+#define PVEC_MASK (EEVO_PVEC_WIDTH - 1)
+
+/* create new node, copying children of from if given */
+static EevoPNode
+pnode_new(EevoPNode from)
+{
+	EevoPNode ret;
+	if (!(ret = malloc(sizeof(struct EevoPNode_))))
+		perror("; malloc"), exit(1);
+	if (from)
+		memcpy(ret, from, sizeof(struct EevoPNode_));
+	else
+		memset(ret, 0, sizeof(struct EevoPNode_));
+	return ret;
+}
+
+Eevo
+eevo_pvec(void)
+{
+	Eevo ret = eevo_val(EEVO_PVEC);
+	ret->v.pv.len = 0;
+	ret->v.pv.shift = EEVO_PVEC_BITS;
+	ret->v.pv.root = pnode_new(NULL);
+	ret->v.pv.tail = pnode_new(NULL);
+	return ret;
+}
+
+/* index of first element in tail */
+static int
+pvec_tailoff(Eevo pv)
+{
+	if (pv->v.pv.len < EEVO_PVEC_WIDTH)
+		return 0;
+	return ((pv->v.pv.len - 1) >> EEVO_PVEC_BITS) << EEVO_PVEC_BITS;
+}
+
+/* return leaf node holding element i */
+static EevoPNode
+pvec_leaf(Eevo pv, int i)
+{
+	EevoPNode n;
+	if (i >= pvec_tailoff(pv))
+		return pv->v.pv.tail;
+	n = pv->v.pv.root;
+	for (int level = pv->v.pv.shift; level > 0; level -= EEVO_PVEC_BITS)
+		n = n->s[(i >> level) & PVEC_MASK];
+	return n;
+}
+
+/* return element i of persistent vector */
+static Eevo
+pvec_nth(Eevo pv, int i)
+{
+	return pvec_leaf(pv, i)->s[i & PVEC_MASK];
+}
+
+/* create branch nodes from given level down to leaf */
+static EevoPNode
+pnode_path(int level, EevoPNode leaf)
+{
+	EevoPNode ret;
+	if (level == 0)
+		return leaf;
+	ret = pnode_new(NULL);
+	ret->s[0] = pnode_path(level - EEVO_PVEC_BITS, leaf);
+	return ret;
+}
+
+/* add full leaf after the last one in tree of vector with len elements,
+ * copying the nodes along the way unless changing them in place */
+static EevoPNode
+pnode_push(int len, int level, EevoPNode parent, EevoPNode leaf, int copy)
+{
+	int i = ((len - 1) >> level) & PVEC_MASK;
+	EevoPNode ret = copy ? pnode_new(parent) : parent;
+	if (level == EEVO_PVEC_BITS)
+		ret->s[i] = leaf;
+	else if (ret->s[i])
+		ret->s[i] = pnode_push(len, level - EEVO_PVEC_BITS, ret->s[i], leaf, copy);
+	else
+		ret->s[i] = pnode_path(level - EEVO_PVEC_BITS, leaf);
+	return ret;
+}
+
+/* add value to end of persistent vector, returning new vector if copy is set,
+ * otherwise changing the given one in place, only done while building it */
+static Eevo
+pvec_conj(Eevo pv, Eevo v, int copy)
+{
+	Eevo ret = pv;
+	int len = pv->v.pv.len, off = pvec_tailoff(pv);
+	if (copy) {
+		ret = eevo_val(EEVO_PVEC);
+		ret->v.pv = pv->v.pv;
+	}
+	if (len - off < EEVO_PVEC_WIDTH) { /* room left in tail */
+		if (copy)
+			ret->v.pv.tail = pnode_new(pv->v.pv.tail);
+		ret->v.pv.tail->s[len - off] = v;
+	} else { /* move full tail into tree */
+		if ((len >> EEVO_PVEC_BITS) > (1 << ret->v.pv.shift)) { /* root is full */
+			EevoPNode root = pnode_new(NULL);
+			root->s[0] = ret->v.pv.root;
+			root->s[1] = pnode_path(ret->v.pv.shift, ret->v.pv.tail);
+			ret->v.pv.root = root;
+			ret->v.pv.shift += EEVO_PVEC_BITS;
+		} else {
+			ret->v.pv.root = pnode_push(len, ret->v.pv.shift, ret->v.pv.root,
+			                            ret->v.pv.tail, copy);
+		}
+		ret->v.pv.tail = pnode_new(NULL);
+		ret->v.pv.tail->s[0] = v;
+	}
+	ret->v.pv.len++;
+	return ret;
+}
+
+/* copy path to the leaf holding element i, replacing it with v */
+static EevoPNode
+pnode_assoc(int level, EevoPNode n, int i, Eevo v)
+{
+	EevoPNode ret = pnode_new(n);
+	if (level == 0)
+		ret->s[i & PVEC_MASK] = v;
+	else
+		ret->s[(i >> level) & PVEC_MASK] =
+			pnode_assoc(level - EEVO_PVEC_BITS, n->s[(i >> level) & PVEC_MASK], i, v);
+	return ret;
+}
+
+/* return new persistent vector with element i replaced by v */
+static Eevo
+pvec_assoc(Eevo pv, int i, Eevo v)
+{
+	Eevo ret;
+	if (i == pv->v.pv.len)
+		return pvec_conj(pv, v, 1);
+	ret = eevo_val(EEVO_PVEC);
+	ret->v.pv = pv->v.pv;
+	if (i >= pvec_tailoff(pv)) {
+		ret->v.pv.tail = pnode_new(pv->v.pv.tail);
+		ret->v.pv.tail->s[i & PVEC_MASK] = v;
+	} else {
+		ret->v.pv.root = pnode_assoc(pv->v.pv.shift, pv->v.pv.root, i, v);
+	}
+	return ret;
+}
+
+Eevo
+eevo_numarr(int len)
+{
+	Eevo ret = eevo_val(EEVO_NUMARR);
+	ret->v.na.len = len;
+	if (!(ret->v.na.d = malloc((len > 0 ? len : 1) * sizeof(double))))
+		perror("; malloc"), exit(1);
+	return ret;
+}
+
+Eevo
+eevo_strbuf(size_t cap)
+{
+	Eevo ret = eevo_val(EEVO_STRBUF);
+	ret->v.sb.len = 0;
+	ret->v.sb.cap = cap > 0 ? cap : 1;
+	if (!(ret->v.sb.s = malloc(ret->v.sb.cap)))
+		perror("; malloc"), exit(1);
+	ret->v.sb.s[0] = '\0';
+	return ret;
+}
+
+Eevo
+eevo_rope(Eevo l, Eevo r)
+{
+	Eevo ret = eevo_val(EEVO_ROPE);
+	if (!(ret->v.rope = malloc(sizeof(struct EevoRope_))))
+		perror("; malloc"), exit(1);
+	ret->v.rope->l = l;
+	ret->v.rope->r = r;
+	ret->v.rope->len = text_len(l) + text_len(r);
+	ret->v.rope->flat = NULL;
+	return ret;
+}
+
+/* create view of len characters starting at s, which must be inside parent,
+ * views of views refer to the original string so they can be freed sooner */
+Eevo
+eevo_strview(Eevo parent, char *s, size_t len)
+{
+	Eevo ret = eevo_val(EEVO_STRVIEW);
+	ret->v.sv.s = s;
+	ret->v.sv.len = len;
+	ret->v.sv.parent = parent->t == EEVO_STRVIEW ? parent->v.sv.parent : parent;
+	ret->v.sv.utf8 = NULL;
+	return ret;
+}
+
+/* copy characters of rope into s, without recursing since ropes built by
+ * adding to the end one piece at a time are as deep as they are long */
+static void
+rope_fill(Eevo v, char *s)
+{
+	Eevo *stack = NULL;
+	size_t n = 0, cap = 0, len;
+	for (;;) {
+		if (v->t == EEVO_ROPE && !v->v.rope->flat) { /* right side is done after left */
+			if (n == cap && !(stack = realloc(stack, (cap = 2 * cap + 8) * sizeof(Eevo))))
+				perror("; realloc"), exit(1);
+			stack[n++] = v->v.rope->r;
+			v = v->v.rope->l;
+			continue;
+		}
+		len = text_len(v);
+		memcpy(s, text_chars(v), len);
+		s += len;
+		if (!n)
+			break;
+		v = stack[--n];
+	}
+	free(stack);
+}
+
+/* return characters of rope as one string, which is kept for later */
+static char *
+rope_flat(Eevo v)
+{
+	char *s;
+	if (!v->v.rope->flat) {
+		if (!(s = malloc(v->v.rope->len + 1)))
+			perror("; malloc"), exit(1);
+		rope_fill(v, s);
+		s[v->v.rope->len] = '\0';
+		v->v.rope->flat = s;
+	}
+	return v->v.rope->flat;
+}
+
+/* get next element of list or vector into v, advancing seq or index i
+ * returns 0 once there are no more elements */
+static int
+seq_next(Eevo *seq, int *i, Eevo *v)
+{
+	if ((*seq)->t == EEVO_VEC) {
+		if (*i >= (*seq)->v.vec.len)
+			return 0;
+		*v = (*seq)->v.vec.items[(*i)++];
+		return 1;
+	}
+	if ((*seq)->t == EEVO_PVEC) {
+		if (*i >= (*seq)->v.pv.len)
+			return 0;
+		*v = pvec_nth(*seq, (*i)++);
+		return 1;
+	}
+	if ((*seq)->t == EEVO_NUMARR) {
+		if (*i >= (*seq)->v.na.len)
+			return 0;
+		*v = eevo_dec((*seq)->v.na.d[(*i)++]);
+		return 1;
+	}
+	if ((*seq)->t != EEVO_PAIR)
+		return 0;
+	*v = fst(*seq);
+	*seq = rst(*seq);
+	return 1;
+}
+
+/* maps
+ * keys can be any value, found by hashing them consistently with vals_eq
+ * entries are packed in the order they were added, with a separate index of their
+ * positions, deleted entries are only removed once the map is resized */
+
+/* hash decimal number bits, so equal integers and decimals hash the same */
+static uint32_t
+num_hash(double d)
+{
+	unsigned long long u;
+	if (d == 0) /* -0.0 is equal to 0.0 */
+		d = 0;
+	memcpy(&u, &d, sizeof(u));
+	u ^= u >> 33; /* mix bits, since low bits of whole numbers are all 0 */
+	u *= 0xff51afd7ed558ccdULL;
+	u ^= u >> 33;
+	return u;
+}
+
+/* return hash of value, values which are equal always have the same hash */
+static uint32_t
+val_hash(Eevo v)
+{
+	uint32_t h = v->t;
+	if (v->t & EEVO_NUM)
+		return num_hash(num(v)) * 31 + num_hash(den(v));
+	switch (v->t) {
+	case EEVO_STR:
+	case EEVO_SYM:
+		return hash(v->v.s);
+	case EEVO_PAIR:
+		for (; v->t == EEVO_PAIR; v = rst(v))
+			h = h * 31 + val_hash(fst(v));
+		return h * 31 + val_hash(v);
+	case EEVO_FUNC:
+	case EEVO_MACRO:
+		return (h * 31 + val_hash(v->v.f.args)) * 31 + val_hash(v->v.f.body);
+	case EEVO_VEC:
+		for (int i = 0; i < v->v.vec.len; i++)
+			h = h * 31 + val_hash(v->v.vec.items[i]);
+		return h;
+	case EEVO_PVEC:
+		for (int i = 0; i < v->v.pv.len; i++)
+			h = h * 31 + val_hash(pvec_nth(v, i));
+		return h;
+	case EEVO_NUMARR:
+		for (int i = 0; i < v->v.na.len; i++)
+			h = h * 31 + num_hash(v->v.na.d[i]);
+		return h;
+	case EEVO_STRBUF: /* equal to string of same characters */
+	case EEVO_ROPE:
+	case EEVO_STRVIEW:
+		return hash_n(text_chars(v), text_len(v));
+	case EEVO_REGEX:
+		return h * 31 + hash(v->v.re->pat);
+	case EEVO_MAP:
+	case EEVO_SET: /* independent of order entries were added */
+		for (int i = 0; i < v->v.m->used; i++)
+			if (v->v.m->items[i].key)
+				h += v->v.m->items[i].hash * 31 + val_hash(v->v.m->items[i].val);
+		return h;
+	default: /* compared by identity */
+		return (uintptr_t)v >> 3;
+	}
+}
+
+/* rebuild map with room for n entries, dropping deleted ones */
+static void
+map_resize(EevoMap m, int n)
+{
+	int i, j, c = 0;
+	m->cap = EEVO_REC_FACTOR * (n + 1);
+	free(m->index);
+	if (!(m->index = calloc(m->cap, sizeof(int))))
+		perror("; calloc"), exit(1);
+	for (i = 0; i < m->used; i++) { /* pack live entries and index them */
+		if (!m->items[i].key)
+			continue;
+		m->items[c] = m->items[i];
+		j = m->items[c].hash % m->cap;
+		while (m->index[j])
+			j = (j + 1) % m->cap;
+		m->index[j] = ++c;
+	}
+	m->used = c;
+	if (!(m->items = realloc(m->items, (m->cap / EEVO_REC_FACTOR + 1) *
+	                                   sizeof(struct EevoMapEntry_))))
+		perror("; realloc"), exit(1);
+}
+
+Eevo
+eevo_map(EevoType t, int cap)
+{
+	Eevo ret = eevo_val(t);
+	if (!(ret->v.m = malloc(sizeof(struct EevoMap_))))
+		perror("; malloc"), exit(1);
+	ret->v.m->size = ret->v.m->used = 0;
+	ret->v.m->items = NULL;
+	ret->v.m->index = NULL;
+	map_resize(ret->v.m, cap);
+	return ret;
+}
+
+/* get slot of map index for key with hash h, or empty one to be filled */
+static int *
+map_slot(EevoMap m, Eevo key, uint32_t h)
+{
+	int *p, i = h % m->cap;
+	while (*(p = &m->index[i])) {
+		if (*p > 0 && m->items[*p - 1].hash == h && vals_eq(m->items[*p - 1].key, key))
+			break;
+		if (++i == m->cap)
+			i = 0;
+	}
+	return p;
+}
+
+/* return value of key in map, or NULL if it is not found */
+static Eevo
+map_get(EevoMap m, Eevo key)
+{
+	int i = *map_slot(m, key, val_hash(key));
+	return i > 0 ? m->items[i - 1].val : NULL;
+}
+
+/* set value of key in map, adding it if not already present */
+static void
+map_put(EevoMap m, Eevo key, Eevo val)
+{
+	uint32_t h = val_hash(key);
+	int *p = map_slot(m, key, h);
+	if (*p) {
+		m->items[*p - 1].val = val;
+		return;
+	}
+	m->items[m->used].key = key;
+	m->items[m->used].val = val;
+	m->items[m->used].hash = h;
+	*p = ++m->used;
+	/* resize if index is more than half full, including deleted entries */
+	if (++m->size, m->used > m->cap / EEVO_REC_FACTOR)
+		map_resize(m, EEVO_REC_FACTOR * m->size);
+}
+
+/* remove key from map, returning 0 if it was not found */
+static int
+map_del(EevoMap m, Eevo key)
+{
+	int *p = map_slot(m, key, val_hash(key));
+	if (!*p)
+		return 0;
+	m->items[*p - 1].key = NULL;
+	*p = -1; /* keep searching past deleted entry */
+	m->size--;
+	return 1;
+}
+
 /* TODO swap eevo_rec and rec_new */
 Eevo
 eevo_rec(EevoSt st, EevoRec prev, Eevo records)
 {
-	int cap;
 	Eevo v, ret = eevo_val(EEVO_REC);
 	if (!records)
 		return ret->v.r = prev, ret;
-	cap = EEVO_REC_FACTOR * eevo_lstlen(records);
-	ret->v.r = rec_new(cap > 0 ? cap : -cap + 1, NULL);
-	EevoRec r = rec_new(4, prev);
+	/* small records keep their keys in order, larger ones are hashed into trie */
+	ret->v.r = abs(eevo_lstlen(records)) <= EEVO_FRAME_CAP ? rec_new_linear(NULL) : rec_new_trie();
+	EevoRec r = rec_new_linear(prev);
 	rec_add(r, "this", ret);
 	for (Eevo cur = records; cur->t == EEVO_PAIR; cur = rst(cur))
 		if (fst(cur)->t == EEVO_PAIR && ffst(cur)->t & (EEVO_SYM|EEVO_STR)) {
@@ -429,6 +1510,7 @@ eevo_rec(EevoSt st, EevoRec prev, Eevo records)
 				return NULL;
 			rec_add(ret->v.r, fst(cur)->v.s, v);
 		} else eevo_warn("Rec: missing key symbol or string");
+	rec_shape(st, ret->v.r);
 	return ret;
 }
 
@@ -531,6 +1613,8 @@ read_num(EevoSt st)
 			eevo_warn("incorrect ratio format, no denominator found");
 		return eevo_rat(sign * num, read_sign(st) * read_int(st));
 	case '.':
+		if (eevo_fgetat(st, 1) == '.') /* range, eg 0..n */
+			return eevo_int(sign * num);
 		eevo_finc(st);
 		oldc = st->filec;
 		double d = (double) read_int(st);
@@ -639,6 +1723,44 @@ read_pair(EevoSt st, char endchar)
 	return rst(ret);
 }
 
+/* split format string into list of literal strings and expressions inside curly
+ * braces, returns just the string if it contains no expressions */
+static Eevo
+read_strfmt(EevoSt st, char *str)
+{
+	Eevo v, ret = eevo_pair(NULL, Nil), pos = ret;
+	char *file = st->file, *buf;
+	size_t filec = st->filec;
+	int len = 0;
+	if (!(buf = malloc(strlen(str) + 1)))
+		perror("; malloc"), exit(1);
+	while (*str)
+		if (*str == '{' && str[1] != '{') {
+			if (len) /* add literal read so far */
+				pos = rst(pos) = eevo_pair(eevo_str(st, esc_str(buf, len, 0)), Nil);
+			len = 0;
+			st->file = ++str, st->filec = 0;
+			/* TODO skip until } to allow for comments */
+			v = read_pair(st, '}');
+			str += st->filec;
+			st->file = file, st->filec = filec;
+			if (!v)
+				return free(buf), NULL;
+			pos = rst(pos) = eevo_pair(v, Nil);
+		} else {
+			/* only add 1 curly brace when escaped */
+			if ((*str == '{' || *str == '}') && str[1] == *str)
+				str++;
+			buf[len++] = *str++;
+		}
+	if (len || ret == pos)
+		pos = rst(pos) = eevo_pair(eevo_str(st, esc_str(buf, len, 0)), Nil);
+	free(buf);
+	if (nilp(rrst(ret)) && snd(ret)->t == EEVO_STR)
+		return snd(ret); /* no expressions to interpolate */
+	return rst(ret);
+}
+
 /* reads given string returning its eevo value */
 Eevo
 eevo_read_sexpr(EevoSt st)
@@ -651,7 +1773,6 @@ eevo_read_sexpr(EevoSt st)
 		",@",  "unquote-splice", /* always check before , */
 		",",   "unquote",
 		"@",   "Func",
-		"f\"", "strfmt",
 		/* "?",   "try?", */
 		/* "$",   "system!", */
 		/* "-",   "negative", */
@@ -668,10 +1789,22 @@ eevo_read_sexpr(EevoSt st)
 		return read_str(st, eevo_str);
 	if (eevo_fget(st) == '~') /* explicit symbol */
 		return read_str(st, eevo_sym);
+	if (eevo_fget(st) == 'f' && eevo_fgetat(st, 1) == '"') { /* format string */
+		Eevo v; eevo_finc(st);
+		if (!(v = read_str(st, eevo_str)) || !(v = read_strfmt(st, v->v.s)))
+			return NULL;
+		/* call form directly, so the split pieces can't be given by hand */
+		return v->t == EEVO_STR ? v : eevo_pair(eevo_prim(EEVO_FORM, form_fstr, "strfmt"), v);
+	}
+	if (eevo_fget(st) == '#' && eevo_fgetat(st, 1) == '[') { /* vector */
+		Eevo v; eevo_fincn(st, 2);
+		if (!(v = read_pair(st, ']'))) return NULL;
+		return eevo_pair(eevo_sym(st, "Vec"), v);
+	}
 	for (int i = 0; i < LEN(prefix); i += 2) { /* character prefix */
 		if (!strncmp(st->file+st->filec, prefix[i], strlen(prefix[i]))) {
 			Eevo v;
-			eevo_fincn(st, strlen(prefix[i]) - (prefix[i][1] == '"'));
+			eevo_fincn(st, strlen(prefix[i]));
 			if (!(v = eevo_read(st))) return NULL;
 			return eevo_list(st, 2, eevo_sym(st, prefix[i+1]), v);
 		}
@@ -682,8 +1815,11 @@ eevo_read_sexpr(EevoSt st)
 		return read_sym(st, &is_sym);
 	if (eevo_fget(st) == '(') /* list */
 		return eevo_finc(st), read_pair(st, ')');
-	if (eevo_fget(st) == '[') /* list */
-		return eevo_finc(st), eevo_pair(eevo_sym(st, "list"), read_pair(st, ']'));
+	if (eevo_fget(st) == '[') { /* list */
+		Eevo v; eevo_finc(st);
+		if (!(v = read_pair(st, ']'))) return NULL;
+		return eevo_pair(eevo_sym(st, "list"), v);
+	}
 	if (eevo_fget(st) == '{') { /* record */
 		Eevo v; eevo_finc(st);
 		if (!(v = read_pair(st, '}'))) return NULL;
@@ -801,35 +1937,57 @@ eevo_eval_list(EevoSt st, EevoRec env, Eevo v)
 	return rst(ret);
 }
 
-/* evaluate all elements of list returning last */
-Eevo
-eevo_eval_body(EevoSt st, EevoRec env, Eevo body)
+/* number of types included in type bits */
+static int
+type_count(EevoType t)
 {
-	Eevo ret = Void;
-	for (; body->t == EEVO_PAIR; body = rst(body))
-		if (nilp(rst(body)) && fst(body)->t == EEVO_PAIR) { /* func call is last, do tail call */
-			Eevo f, args;
-			if (!(f = eevo_eval(st, env, ffst(body))))
-				return NULL;
-			if (f->t != EEVO_FUNC)
-				return eval_proc(st, env, f, rfst(body));
-			eevo_arg_num(rfst(body), f->v.f.name ? f->v.f.name : "anon",
-			            eevo_lstlen(f->v.f.args));
-			if (!(args = eevo_eval_list(st, env, rfst(body))))
-				return NULL;
-			if (!(env = rec_extend(f->v.f.env, f->v.f.args, args)))
-				return NULL;
-			/* continue loop from body of func call */
-			body = eevo_pair(NULL, f->v.f.body);
-		} else if (!(ret = eevo_eval(st, env, fst(body))))
-			return NULL;
+	int n = 0;
+	for (; t; t &= t - 1)
+		n++;
+	return n;
+}
+
+/* return method of generic f matching types of given arguments, otherwise
+ *   searching for method with the most specific types which the arguments match
+ * call site remembers generic, its version and argument types of last call, so
+ *   calls from same site with same types only compare a few words, calls
+ *   without a site such as apply use the generic itself as their site */
+static Eevo
+gen_method(EevoSt st, Eevo f, Eevo args, Eevo site)
+{
+	EevoGen g = f->v.g;
+	EevoType types[EEVO_GEN_ARGS] = { 0 };
+	Eevo m, t, a, ret = NULL;
+	int i, score, best = INT_MAX;
+	struct EevoGenSite_ *c = &st->gens[((uintptr_t)(site ? site : f) >> 4) % EEVO_GEN_CACHE];
+	eevo_arg_num(args, g->name, eevo_lstlen(g->args));
+	for (i = 0, a = args; i < EEVO_GEN_ARGS && a->t == EEVO_PAIR; i++, a = rst(a))
+		types[i] = fst(a)->t;
+	if (c->gen == f && c->version == g->version && !memcmp(c->types, types, sizeof(types)))
+		return c->func;
+	for (m = g->methods; m->t == EEVO_PAIR; m = rst(m)) {
+		for (score = 0, t = ffst(m), a = args; t->t == EEVO_PAIR; t = rst(t), a = rst(a))
+			if (nilp(fst(t))) /* argument can be any type */
+				score += 8 * sizeof(EevoType);
+			else if (fst(a)->t & fst(t)->v.t.t)
+				score += type_count(fst(t)->v.t.t);
+			else
+				break;
+		if (nilp(t) && score < best)
+			best = score, ret = rfst(m);
+	}
+	if (!ret)
+		eevo_warnf("%s: no method found for arguments of type %s", g->name,
+		           nilp(args) ? "Nil" : eevo_type_str(fst(args)->t));
+	c->gen = f, c->version = g->version, c->func = ret;
+	memcpy(c->types, types, sizeof(types));
 	return ret;
 }
 
 static void
 prepend_bt(EevoSt st, EevoRec env, Eevo f)
 {
-	if (!f->v.f.name) /* no need to record anonymous functions */
+	if (!f->v.f.name || st->tag) /* no need to record anonymous functions or throws */
 		return;
 	for (; env->next; env = env->next) ; /* bt var located at base env */
 	EevoEntry e = entry_get(env, "bt");
@@ -839,6 +1997,91 @@ prepend_bt(EevoSt st, EevoRec env, Eevo f)
 	e->val = eevo_pair(eevo_sym(st, f->v.f.name), e->val);
 }
 
+/* evaluate all elements of list returning last
+ * the last expression is evaluated in the same loop if it calls a function, or
+ * if it is a macro, cond, or do which leads to one, so that recursion in tail
+ * position does not grow the stack, calls of the same function reuse its frame */
+Eevo
+eevo_eval_body(EevoSt st, EevoRec env, Eevo body)
+{
+	Eevo ret = Void, expr, f, v, args, self = NULL;
+	EevoRec fenv, frame = NULL; /* frame created for tail call, released when done */
+	while (body->t == EEVO_PAIR) {
+		if (!nilp(rst(body))) {
+			if (!(ret = eevo_eval(st, env, fst(body))))
+				return NULL;
+			body = rst(body);
+			continue;
+		}
+		expr = fst(body);
+tail:
+		if (expr->t != EEVO_PAIR) {
+			ret = eevo_eval(st, env, expr);
+			break;
+		}
+		if (!(f = eevo_eval(st, env, fst(expr))))
+			return NULL;
+		ret = Void, body = Nil;
+		if (f->t == EEVO_MACRO) { /* expand macro, then evaluate result as last expression */
+			eevo_arg_num(rst(expr), f->v.f.name ? f->v.f.name : "anon",
+			             eevo_lstlen(f->v.f.args));
+			if (!(fenv = rec_extend(st, f, rst(expr))))
+				return NULL;
+			expr = eevo_eval_body(st, fenv, f->v.f.body);
+			frame_release(st, fenv);
+			if (!expr)
+				return prepend_bt(st, env, f), NULL;
+			goto tail;
+		} else if (f->t == EEVO_FORM && f->v.pr.pr == form_cond) {
+			for (v = rst(expr); !nilp(v); v = rst(v))
+				if (!(ret = eevo_eval(st, env, ffst(v))))
+					return NULL;
+				else if (!nilp(ret)) /* continue with body of true condition */
+					break;
+			if (!nilp(v))
+				body = rfst(v);
+			ret = Void;
+		} else if (f->t == EEVO_FORM && f->v.pr.pr == eevo_eval_body) {
+			body = rst(expr);
+		} else if (f->t & (EEVO_FUNC | EEVO_GEN)) {
+			if (f->t == EEVO_GEN) {
+				if (!(args = eevo_eval_list(st, env, rst(expr))) ||
+				    !(f = gen_method(st, f, args, rst(expr))))
+					return NULL;
+				if (f->t != EEVO_FUNC) {
+					ret = eval_apply(st, env, f, args);
+					break;
+				}
+			} else {
+				eevo_arg_num(rst(expr), f->v.f.name ? f->v.f.name : "anon",
+				             eevo_lstlen(f->v.f.args));
+				if (!(args = eevo_eval_list(st, env, rst(expr))))
+					return NULL;
+			}
+			if (f == self && frame->linear && !frame->escaped) {
+				/* calling itself, overwrite arguments in place */
+				frame->size = 0;
+				frame_fill(frame, f->v.f.args, args);
+			} else {
+				if (!(fenv = rec_extend(st, f, args)))
+					return NULL;
+				if (frame) /* previous frame is no longer needed */
+					frame_release(st, frame);
+				env = frame = fenv;
+				self = f;
+			}
+			/* continue loop from body of func call */
+			body = f->v.f.body;
+		} else {
+			ret = eval_proc(st, env, f, rst(expr));
+			break;
+		}
+	}
+	if (frame)
+		frame_release(st, frame);
+	return ret;
+}
+
 /* evaluate procedure f with arguments */
 static Eevo
 eval_proc(EevoSt st, EevoRec env, Eevo f, Eevo args)
@@ -859,22 +2102,33 @@ eval_proc(EevoSt st, EevoRec env, Eevo f, Eevo args)
 		/* FALLTHROUGH */
 	case EEVO_MACRO:
 		eevo_arg_num(args, f->v.f.name ? f->v.f.name : "anon", eevo_lstlen(f->v.f.args));
-		if (!(fenv = rec_extend(f->v.f.env, f->v.f.args, args)))
+		if (!(fenv = rec_extend(st, f, args)))
 			return NULL;
-		if (!(ret = eevo_eval_body(st, fenv, f->v.f.body)))
+		ret = eevo_eval_body(st, fenv, f->v.f.body);
+		frame_release(st, fenv);
+		if (!ret)
 			return prepend_bt(st, env, f), NULL;
 		if (f->t == EEVO_MACRO) /* TODO remove w/ expand_macro */
 			ret = eevo_eval(st, env, ret);
 		return ret;
-	case EEVO_REC:
+	case EEVO_REC: /* rec::key is read as (rec 'key), take key from quote */
+		if (args->t == EEVO_PAIR && nilp(rst(args)) && fst(args)->t == EEVO_PAIR &&
+		    ffst(args)->t == EEVO_SYM && !strcmp(ffst(args)->v.s, "quote") &&
+		    rfst(args)->t == EEVO_PAIR && fst(rfst(args))->t == EEVO_SYM)
+			return rec_prop(st, f->v.r, fst(rfst(args))->v.s, args);
+		if (!(ret = eevo_eval_list(st, env, args)))
+			return NULL;
+		eevo_arg_num(ret, "record", 1);
+		eevo_arg_type(fst(ret), "record", EEVO_SYM);
+		return rec_prop(st, f->v.r, fst(ret)->v.s, args);
+	case EEVO_GEN:
+		if (!(ret = eevo_eval_list(st, env, args)) || !(f = gen_method(st, f, ret, args)))
+			return NULL;
+		return eval_apply(st, env, f, ret);
+	case EEVO_NUMFN:
 		if (!(args = eevo_eval_list(st, env, args)))
 			return NULL;
-		eevo_arg_num(args, "record", 1);
-		eevo_arg_type(fst(args), "record", EEVO_SYM);
-		if (!(ret = rec_get(f->v.r, fst(args)->v.s)) &&
-		    !(ret = rec_get(f->v.r, "else")))
-			eevo_warnf("could not find element '%s' in record", fst(args)->v.s);
-		return ret;
+		return numfn_call(f, args);
 	case EEVO_TYPE:
 		if (f->v.t.func)
 			return eval_proc(st, env, f->v.t.func, args);
@@ -886,6 +2140,38 @@ eval_proc(EevoSt st, EevoRec env, Eevo f, Eevo args)
 	}
 }
 
+/* apply procedure f to list of already evaluated arguments */
+static Eevo
+eval_apply(EevoSt st, EevoRec env, Eevo f, Eevo args)
+{
+	Eevo ret, qargs, pos;
+	EevoRec fenv;
+	switch (f->t) {
+	case EEVO_PRIM:
+		return (*f->v.pr.pr)(st, env, args);
+	case EEVO_FUNC:
+		eevo_arg_num(args, f->v.f.name ? f->v.f.name : "anon", eevo_lstlen(f->v.f.args));
+		if (!(fenv = rec_extend(st, f, args)))
+			return NULL;
+		ret = eevo_eval_body(st, fenv, f->v.f.body);
+		frame_release(st, fenv);
+		if (!ret)
+			return prepend_bt(st, env, f), NULL;
+		return ret;
+	case EEVO_GEN:
+		if (!(ret = gen_method(st, f, args, NULL)))
+			return NULL;
+		return eval_apply(st, env, ret, args);
+	case EEVO_NUMFN:
+		return numfn_call(f, args);
+	default: /* quote arguments to prevent them from being evaluated twice */
+		qargs = pos = eevo_pair(NULL, Nil);
+		for (; args->t == EEVO_PAIR; args = rst(args))
+			pos = rst(pos) = eevo_pair(eevo_list(st, 2, eevo_sym(st, "quote"), fst(args)), Nil);
+		return eval_proc(st, env, f, rst(qargs));
+	}
+}
+
 /* evaluate given value */
 Eevo
 eevo_eval(EevoSt st, EevoRec env, Eevo v)
@@ -925,18 +2211,44 @@ print_size(Eevo v)
 		if (!v->v.f.name) return 5; /* anon */
 		return strlen(v->v.f.name) + 1;
 	case EEVO_PRIM:
-	case EEVO_FORM: return strlen(v->v.pr.name);
-	case EEVO_TYPE: return strlen(v->v.t.name);
-	case EEVO_REC:
-		for (EevoRec r = v->v.r; r; r = r->next)
-			for (int i = 0, c = 0; c < r->size; i++)
-				if (r->items[i].key) {
-					len += strlen(r->items[i].key) +
-					       print_size(r->items[i].val) + 2;
-					c++;
-				}
+	case EEVO_FORM: return strlen(v->v.pr.name) + 1;
+	case EEVO_TYPE: return strlen(v->v.t.name) + 1;
+	case EEVO_GEN:  return strlen(v->v.g->name) + 1;
+	case EEVO_NUMFN: return 8;
+	case EEVO_STRBUF:
+	case EEVO_ROPE:
+	case EEVO_STRVIEW: return text_len(v) + 1;
+	case EEVO_REGEX: return strlen(v->v.re->pat) + 1;
+	case EEVO_VEC:
+		for (int i = 0; i < v->v.vec.len; i++)
+			len += print_size(v->v.vec.items[i]);
+		return len + 1;
+	case EEVO_PVEC:
+		for (int i = 0; i < v->v.pv.len; i++)
+			len += print_size(pvec_nth(v, i));
+		return len + 1;
+	case EEVO_NUMARR:
+		for (int i = 0; i < v->v.na.len; i++)
+			len += snprintf(NULL, 0, "%.15G ", v->v.na.d[i]);
+		return len + 1;
+	case EEVO_MAP:
+	case EEVO_SET:
+		for (int i = 0; i < v->v.m->used; i++)
+			if (v->v.m->items[i].key)
+				len += print_size(v->v.m->items[i].key) +
+				       (v->t == EEVO_MAP ? print_size(v->v.m->items[i].val) : 0);
+		return len + 1;
+	case EEVO_REC: {
+		EevoEntry *ents = rec_entries(v->v.r);
+		for (int i = 0; i < v->v.r->size; i++)
+			len += strlen(ents[i]->key) + print_size(ents[i]->val) + 2;
+		free(ents);
 		return len;
-	case EEVO_PAIR: return print_size(fst(v)) + print_size(rst(v)) + 1;
+	}
+	case EEVO_PAIR:
+		for (; v->t == EEVO_PAIR; v = rst(v))
+			len += print_size(fst(v));
+		return len + (nilp(v) ? 1 : print_size(v));
 	default:        return 0;
 	}
 }
@@ -946,17 +2258,15 @@ static void
 print_rec(char *ret, EevoRec rec)
 {
 	int len = 0;
-	for (EevoRec r = rec; r; r = r->next)
-		for (int i = 0, c = 0; c < r->size; i++)
-			if (r->items[i].key) {
-				int olen = len;
-				char *key = r->items[i].key;
-				char *val = eevo_print(r->items[i].val);
-				len += strlen(key) + strlen(val) + 2;
-				snprintf(ret + strlen(ret), len-olen, "%s:%s", key, val);
-				free(val);
-				c++;
-			}
+	EevoEntry *ents = rec_entries(rec);
+	for (int i = 0; i < rec->size; i++) {
+		int olen = len;
+		char *val = eevo_print(ents[i]->val);
+		len += strlen(ents[i]->key) + strlen(val) + 2;
+		snprintf(ret + strlen(ret), len-olen, "%s:%s", ents[i]->key, val);
+		free(val);
+	}
+	free(ents);
 }
 
 /* Convert eevo value to string to be printed
@@ -1003,16 +2313,68 @@ eevo_print(Eevo v)
 	case EEVO_TYPE:
 		strcat(ret, v->v.t.name);
 		break;
+	case EEVO_GEN:
+		strcat(ret, v->v.g->name);
+		break;
+	case EEVO_NUMFN:
+		strcat(ret, "NumFunc");
+		break;
+	case EEVO_STRBUF:
+		strcat(ret, v->v.sb.s);
+		break;
+	case EEVO_ROPE:
+		strcat(ret, rope_flat(v));
+		break;
+	case EEVO_STRVIEW:
+		memcpy(ret, v->v.sv.s, v->v.sv.len);
+		break;
+	case EEVO_REGEX:
+		strcat(ret, v->v.re->pat);
+		break;
+	case EEVO_VEC:
+		for (int i = 0; i < v->v.vec.len; i++) {
+			head = eevo_print(v->v.vec.items[i]);
+			strcat(ret, head);
+			free(head);
+		}
+		break;
+	case EEVO_PVEC:
+		for (int i = 0; i < v->v.pv.len; i++) {
+			head = eevo_print(pvec_nth(v, i));
+			strcat(ret, head);
+			free(head);
+		}
+		break;
+	case EEVO_NUMARR:
+		for (int i = 0; i < v->v.na.len; i++)
+			snprintf(ret + strlen(ret), size - strlen(ret), i ? " %.15G" : "%.15G",
+			         v->v.na.d[i]);
+		break;
+	case EEVO_MAP:
+	case EEVO_SET:
+		for (int i = 0; i < v->v.m->used; i++) {
+			if (!v->v.m->items[i].key)
+				continue;
+			head = eevo_print(v->v.m->items[i].key);
+			strcat(ret, head);
+			free(head);
+			if (v->t == EEVO_MAP) {
+				tail = eevo_print(v->v.m->items[i].val);
+				strcat(strcat(ret, ":"), tail);
+				free(tail);
+			}
+		}
+		break;
 	case EEVO_REC:
 		print_rec(ret, v->v.r);
 		break;
-	case EEVO_PAIR:
-		head = eevo_print(fst(v));
-		tail = nilp(rst(v)) ? "" : eevo_print(rst(v));
-		snprintf(ret, size, "%s%s", head, tail);
-		free(head);
-		if (!nilp(rst(v)))
-			free(tail);
+	case EEVO_PAIR: /* copy each element after the last, including improper end */
+		for (tail = ret; !nilp(v); v = v->t == EEVO_PAIR ? rst(v) : Nil) {
+			if (!(head = eevo_print(v->t == EEVO_PAIR ? fst(v) : v)))
+				return free(ret), NULL;
+			tail = strchr(strcpy(tail, head), '\0');
+			free(head);
+		}
 		break;
 	default:
 		free(ret);
@@ -1047,6 +2409,14 @@ eevo_env_init(size_t cap)
 	st->syms = rec_new(cap, NULL);
 
 	st->env = rec_new(cap, NULL);
+	st->frames = NULL;
+	st->loops = Nil;
+	st->catches = Nil;
+	st->tag = st->thrown = NULL;
+	if (!(st->shapes = calloc(1, sizeof(struct EevoShape_))))
+		perror("; calloc"), exit(1);
+	memset(st->props, 0, sizeof(st->props));
+	memset(st->gens, 0, sizeof(st->gens));
 	eevo_env_add(st, "True", True);
 	eevo_env_add(st, "Nil", Nil);
 	eevo_env_add(st, "Void", Void);
@@ -1071,9 +2441,19 @@ eevo_env_init(size_t cap)
 	/* st->types[11] = eevo_type(st, EEVO_PAIR | EEVO_VOID,  "List",  List); */
 	st->types[12] = eevo_type(st, EEVO_REC,   "Rec",   eevo_prim(EEVO_FORM, eevo_rec,    "Rec"));
 	st->types[13] = eevo_type(st, EEVO_TYPE,  "Type",  eevo_prim(EEVO_PRIM, eevo_typeof, "Type"));
+	st->types[14] = eevo_type(st, EEVO_GEN,   "Generic", NULL);
+	st->types[15] = eevo_type(st, EEVO_VEC,   "Vec",   NULL);
+	st->types[16] = eevo_type(st, EEVO_PVEC,  "PVec",  NULL);
+	st->types[17] = eevo_type(st, EEVO_MAP,   "Map",   NULL);
+	st->types[18] = eevo_type(st, EEVO_SET,   "Set",   NULL);
+	st->types[19] = eevo_type(st, EEVO_NUMARR, "NumArray", NULL);
+	st->types[20] = eevo_type(st, EEVO_NUMFN,  "NumFunc",  NULL);
+	st->types[21] = eevo_type(st, EEVO_STRBUF, "StrBuf",   NULL);
+	st->types[22] = eevo_type(st, EEVO_ROPE,   "Rope",     NULL);
+	st->types[23] = eevo_type(st, EEVO_STRVIEW, "StrView", NULL);
+	st->types[24] = eevo_type(st, EEVO_REGEX,  "Regex",    NULL);
 	for (int i = 0; i < LEN(st->types); i++)
 		eevo_env_add(st, st->types[i]->v.t.name, st->types[i]);
-		/* TODO define type predicate functions here (nil?, string?, etc) */
 
 	st->libh = NULL;
 	st->libhc = 0;
@@ -1104,7 +2484,12 @@ eevo_env_lib(EevoSt st, char* lib)
 
 
 #include "core/core.c"
+#include "core/list.c"
+#include "core/vec.c"
+#include "core/map.c"
+#include "core/array.c"
 #include "core/string.c"
+#include "core/regex.c"
 #include "core/math.c"
 #include "core/io.c"
 #include "core/os.c"
@@ -23,6 +23,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
 
 /* Global literals */
 extern struct Eevo_ eevo_nil;
@@ -30,6 +31,14 @@ extern struct Eevo_ eevo_true;
 extern struct Eevo_ eevo_void;
 
 #define EEVO_REC_FACTOR 2
+#define EEVO_FRAME_CAP  8  /* most entries in call frame or small record before it is hashed */
+#define EEVO_GEN_ARGS   4  /* arguments generic functions can dispatch on */
+#define EEVO_GEN_CACHE  256 /* generic function call sites remembered */
+#define EEVO_PROP_CACHE 256 /* record property access sites remembered */
+#define EEVO_PVEC_BITS  5  /* persistent vector nodes hold 2^bits children */
+#define EEVO_PVEC_WIDTH (1 << EEVO_PVEC_BITS)
+#define EEVO_TRIE_BITS  5  /* bits of key hash used at each level of record trie */
+#define EEVO_UTF8_STRIDE 64 /* code points between offsets kept in index of UTF-8 string */
 
 #define EEVO_OP_CHARS "_+-*/\\|=^<>.:"
 #define EEVO_SYM_CHARS "_!?" "@#$%&~" "*-"
@@ -79,14 +88,38 @@ struct Eevo_;
 typedef struct Eevo_ *Eevo;
 typedef struct EevoSt_ *EevoSt;
 
-typedef struct EevoEntry_ *EevoEntry;
+typedef struct EevoEntry_ {
+	char *key;
+	Eevo val;
+} *EevoEntry;
+
+/* node of persistent hash trie, each slot holds an entry or a child node */
+typedef struct EevoNode_ {
+	uint32_t map; /* bit set for each part of the hash present in node */
+	int len;
+	struct EevoSlot_ {
+		struct EevoEntry_ e;     /* entry if key is set */
+		struct EevoNode_ *sub;   /* otherwise child node */
+	} slots[];
+} *EevoNode;
+
+/* layout of keys shared by small records which added the same keys in the same
+ * order, linking to each shape made by adding one more key to it */
+typedef struct EevoShape_ {
+	char *key; /* last key added, NULL for the empty shape */
+	struct EevoShape_ *kids, *next; /* shapes with one more key, next sibling */
+} *EevoShape;
 
 typedef struct EevoRec_ {
 	int size, cap;
-	struct EevoEntry_ {
-		char *key;
-		Eevo val;
-	} *items;
+	int linear;  /* entries are searched linearly instead of through index */
+	int escaped; /* frame is still referenced after its call returns */
+	int loop;    /* frame of loop, definitions are added to the enclosing frame */
+	EevoEntry items; /* entries packed in the order they were added */
+	int *index;      /* hash table of positions in items plus one, 0 if empty */
+	EevoNode root; /* record values keep entries in trie shared between versions */
+	EevoShape shape; /* keys of items if record value is not changed, or NULL */
+	Eevo body;       /* body of function called with frame, NULL otherwise */
 	struct EevoRec_ *next;
 } *EevoRec;
 
@@ -106,12 +139,25 @@ typedef enum {
 	EEVO_PAIR  = 1 << 11, /* pair: building block for lists */
 	EEVO_REC   = 1 << 12, /* record: hash table */
 	EEVO_TYPE  = 1 << 13, /* type: kind of eevo value */
+	EEVO_GEN   = 1 << 14, /* generic: function dispatching on types of arguments */
+	EEVO_VEC   = 1 << 15, /* vector: growable array of values */
+	EEVO_PVEC  = 1 << 16, /* persistent vector: immutable trie of values */
+	EEVO_MAP   = 1 << 17, /* map: hash table keyed by any value */
+	EEVO_SET   = 1 << 18, /* set: hash table of unique values */
+	EEVO_NUMARR = 1 << 19, /* number array: unboxed decimals stored contiguously */
+	EEVO_NUMFN  = 1 << 20, /* number function: expression compiled to run on decimals */
+	EEVO_STRBUF = 1 << 21, /* string buffer: mutable string grown by appending */
+	EEVO_ROPE   = 1 << 22, /* rope: immutable concatenation of strings */
+	EEVO_STRVIEW = 1 << 23, /* string view: part of another string, not copied */
+	EEVO_REGEX  = 1 << 24, /* regular expression: compiled pattern matching strings */
 	EEVO_RATIONAL = EEVO_INT | EEVO_RATIO,
 	EEVO_NUM      = EEVO_RATIONAL | EEVO_DEC,
 	/* TODO rename to expr type to math ? */
 	EEVO_EXPR     = EEVO_NUM | EEVO_SYM | EEVO_PAIR,
 	EEVO_TEXT     = EEVO_STR | EEVO_SYM,
-	EEVO_PROC     = EEVO_FUNC | EEVO_PRIM | EEVO_MACRO | EEVO_FORM,
+	EEVO_CHARS    = EEVO_TEXT | EEVO_STRVIEW,
+	EEVO_STRS     = EEVO_STR | EEVO_STRVIEW | EEVO_STRBUF | EEVO_ROPE, /* equal if same chars */
+	EEVO_PROC     = EEVO_FUNC | EEVO_PRIM | EEVO_MACRO | EEVO_FORM | EEVO_GEN | EEVO_NUMFN,
 	EEVO_LIT      = EEVO_VOID | EEVO_NIL | EEVO_NUM | EEVO_STR | EEVO_PROC,
 	EEVO_LIST     = EEVO_PAIR | EEVO_NIL,
 	EEVO_CALLABLE = EEVO_PROC | EEVO_REC | EEVO_TYPE, // | EEVO_PAIR
@@ -125,6 +171,70 @@ typedef struct EevoTypeVal_ {
 	/* Eevo cond; /1* refinement condition *1/ */
 } EevoTypeVal;
 
+/* node of persistent vector trie, leaves hold values and branches hold nodes */
+typedef struct EevoPNode_ {
+	void *s[EEVO_PVEC_WIDTH];
+} *EevoPNode;
+
+/* hash table of any values, entries are kept in the order they were added */
+typedef struct EevoMap_ {
+	int size, used, cap; /* live entries, entries filled or deleted, index slots */
+	struct EevoMapEntry_ {
+		Eevo key, val;  /* key is NULL once entry is deleted */
+		uint32_t hash;
+	} *items;
+	int *index; /* position in items plus one, 0 if empty, -1 if deleted */
+} *EevoMap;
+
+typedef struct EevoGen_ {
+	char *name;
+	Eevo args;    /* parameters shared by every method */
+	Eevo methods; /* list of methods, each (types ... func) */
+	int version;  /* changed when a method is added, so call sites search again */
+} *EevoGen;
+
+/* expression compiled to flat program of instructions, run on registers which
+ * hold the arguments first, followed by constants and instruction results */
+typedef struct EevoNumFn_ {
+	Eevo args, expr; /* variables and expression compiled from */
+	int argc, len, regc, ret; /* arguments, instructions, registers, result register */
+	struct EevoNumOp_ {
+		enum { NUMOP_ADD, NUMOP_SUB, NUMOP_MUL, NUMOP_DIV, NUMOP_POW, NUMOP_CALL } op;
+		int r, a, b;          /* registers of result and arguments */
+		double (*f)(double);  /* math function to call */
+	} *code;
+	double *regs;
+} *EevoNumFn;
+
+/* concatenation of two strings or ropes, only copied into one string once all
+ * of its characters are needed together */
+typedef struct EevoRope_ {
+	Eevo l, r;
+	size_t len;
+	char *flat; /* NULL until flattened */
+} *EevoRope;
+
+/* code points of string which isn't all ASCII, with the byte offset of every
+ * EEVO_UTF8_STRIDE'th code point so indexing only decodes from the one before */
+typedef struct EevoUtf8_ {
+	size_t len;    /* number of code points */
+	size_t *index; /* byte offset of code point i * EEVO_UTF8_STRIDE */
+} *EevoUtf8;
+
+/* regular expression compiled to a program for an NFA, the states of a DFA
+ * are built from it as they are first needed, see core/regex.c */
+typedef struct EevoRegex_ {
+	char *pat;
+	int len, rlen, ncap; /* instructions, reversed ones, capture positions (2 per group) */
+	struct EevoReInst_ {
+		enum { RE_CLASS, RE_SPLIT, RE_JMP, RE_SAVE, RE_BOL, RE_EOL, RE_MATCH } op;
+		int x, y;  /* byte set, jump targets, or capture position */
+	} *prog, *rprog;           /* program, and one matching backwards to find starts */
+	uint32_t (*cls)[8];        /* sets of bytes matched by each RE_CLASS */
+	struct EevoReDfa_ *dfa[3]; /* states built so far for matches, searches and starts */
+	struct EevoReWork_ *work;  /* space reused by every match */
+} *EevoRegex;
+
 /* bultin function written in C, not eevo */
 typedef Eevo (*EevoPrim)(EevoSt, EevoRec, Eevo);
 
@@ -133,12 +243,24 @@ struct Eevo_ {
 	EevoType t; /* NONE, NIL */
 	union {
 		char *s;                                                /* STRING, SYMBOL */
+		struct { char *s; EevoUtf8 utf8; } str;                 /* code points, NULL until needed */
 		struct { double num, den; } n;                          /* NUMBER */
 		struct { char *name; EevoPrim pr; } pr;                 /* PRIMITIVE, FORM */
 		struct { char *name; Eevo args, body; EevoRec env; } f; /* FUNCTION, MACRO */
 		struct { Eevo fst, rst; } p;                            /* PAIR */
 		EevoRec r;                                              /* REC */
 		EevoTypeVal t;                                          /* TYPE */
+		EevoGen g;                                              /* GENERIC */
+		struct { Eevo *items; int len, cap; } vec;              /* VECTOR */
+		struct { int len, shift; EevoPNode root, tail; } pv;    /* PERSISTENT VECTOR */
+		EevoMap m;                                              /* MAP, SET */
+		struct { double *d; int len; } na;                      /* NUMBER ARRAY */
+		EevoNumFn nf;                                           /* NUMBER FUNCTION */
+		struct { char *s; size_t len, cap; } sb;                /* STRING BUFFER */
+		EevoRope rope;                                          /* ROPE */
+		struct { char *s; size_t len; Eevo parent;              /* STRING VIEW */
+		         EevoUtf8 utf8; } sv;                           /* code points, NULL until needed */
+		EevoRegex re;                                           /* REGEX */
 	} v;
 };
 
@@ -146,8 +268,26 @@ struct Eevo_ {
 struct EevoSt_ {
 	char *file;
 	size_t filec;
-	Eevo types[14];
+	Eevo types[25];
 	EevoRec env, strs, syms;
+	EevoRec frames; /* call frames which have returned, ready to be reused */
+	Eevo loops;     /* tags of loops currently running, innermost first */
+	Eevo catches;   /* tags of catches currently running, innermost first */
+	Eevo tag;       /* tag given to throw or break while unwinding to its catch */
+	Eevo thrown;    /* value given to throw or break */
+	EevoMap exprs;  /* unique symbolic expressions and their simplified forms */
+	EevoShape shapes; /* empty shape, root of every record shape */
+	struct EevoProp_ { /* position of key in records of shape, for each access site */
+		EevoShape shape;
+		char *key;
+		int slot;
+	} props[EEVO_PROP_CACHE];
+	struct EevoGenSite_ { /* method of generic for argument types, for each call site */
+		Eevo gen;
+		int version;
+		EevoType types[EEVO_GEN_ARGS];
+		Eevo func;
+	} gens[EEVO_GEN_CACHE];
 	void **libh;
 	size_t libhc;
 };
@@ -162,6 +302,15 @@ Eevo eevo_str(EevoSt st, char *s);
 Eevo eevo_sym(EevoSt st, char *s);
 Eevo eevo_prim(EevoType t, EevoPrim prim, char *name);
 Eevo eevo_func(EevoType t, char *name, Eevo args, Eevo body, EevoRec env);
+Eevo eevo_gen(char *name, Eevo args);
+Eevo eevo_vec(int cap);
+Eevo eevo_pvec(void);
+Eevo eevo_map(EevoType t, int cap);
+Eevo eevo_numarr(int len);
+Eevo eevo_numfn(Eevo args, Eevo expr);
+Eevo eevo_strbuf(size_t cap);
+Eevo eevo_rope(Eevo l, Eevo r);
+Eevo eevo_strview(Eevo parent, char *s, size_t len);
 Eevo eevo_rec(EevoSt st, EevoRec prev, Eevo records);
 Eevo eevo_pair(Eevo a, Eevo b);
 Eevo eevo_list(EevoSt st, int n, ...);
@@ -180,7 +329,12 @@ EevoSt eevo_env_init(size_t cap);
 Eevo   eevo_env_lib(EevoSt st, char* lib);
 
 void eevo_env_core(EevoSt);
+void eevo_env_list(EevoSt);
+void eevo_env_vec(EevoSt);
+void eevo_env_map(EevoSt);
+void eevo_env_array(EevoSt);
 void eevo_env_string(EevoSt);
+void eevo_env_regex(EevoSt);
 void eevo_env_math(EevoSt);
 void eevo_env_io(EevoSt);
 void eevo_env_os(EevoSt);
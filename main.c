@@ -29,10 +29,15 @@ main(int argc, char *argv[])
 	EevoSt st = eevo_env_init(1024);
 #ifndef EEVO_NOCORE
 	eevo_env_core(st);
+	eevo_env_list(st);
+	eevo_env_vec(st);
+	eevo_env_map(st);
+	eevo_env_array(st);
 	eevo_env_math(st);
 	eevo_env_io(st);
 	eevo_env_os(st);
 	eevo_env_string(st);
+	eevo_env_regex(st);
 	eevo_env_lib(st, eevo_core);
 #endif
 
@@ -47,8 +47,13 @@ main(void)
 	clock_t t;
 	EevoSt st = eevo_env_init(1024);
 	eevo_env_core(st);
+	eevo_env_list(st);
+	eevo_env_vec(st);
+	eevo_env_map(st);
+	eevo_env_array(st);
 	eevo_env_math(st);
 	eevo_env_string(st);
+	eevo_env_regex(st);
 	eevo_env_lib(st, eevo_core);
 
 	t = clock();
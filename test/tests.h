@@ -104,6 +104,59 @@ char *tests[][2] = {
 	{ "(Str (Pair 'hello 'there))",    "\"hellothere\""             },
 	{ "(Str [1 2 3])",                 "\"123\""                    },
 	{ "(Str { a: 1  b: 2 })",          "\"a:1b:2\""                 },
+	{ "(str-find \"hello world\" \"o\")",  "4"                     },
+	{ "(str-find \"hello world\" \"o\" 5)", "7"                    },
+	{ "(str-find \"hello\" \"z\")",        "Nil"                   },
+	{ "(str-find \"aab\" \"ab\")",         "1"                     },
+	{ "(str-contains? \"barbara\" \"bar\")", "True"                },
+	{ "(str-prefix? \"hello\" \"he\")",    "True"                  },
+	{ "(str-suffix? \"lo\" \"hello\")",    "Nil"                   },
+	{ "(str-split \"  a b\\tc  \")",       "[\"a\" \"b\" \"c\"]"     },
+	{ "(str-split \"a,b,,c\" \",\")",      "[\"a\" \"b\" \"\" \"c\"]" },
+	{ "(str-join [\"a\" \"b\" \"c\"] \", \")", "\"a, b, c\""        },
+	{ "(str-join [])",                 "\"\""                       },
+	{ "(str-replace \"a-b-c\" \"-\" \"--\")", "\"a--b--c\""         },
+	{ "(str-replace \"aaa\" \"aa\" \"b\")", "\"ba\""                },
+	{ "(str-trim \"  hi there \\n\")",     "\"hi there\""            },
+	{ "(str-slice \"hello world\" 6)",   "\"world\""               },
+	{ "(str-slice \"hello world\" -5 -2)", "\"wor\""               },
+	{ "(str-slice (str-slice \"abcdef\" 1) 1 3)", "\"cd\""         },
+	{ "(Type (str-trim \" a \"))",        "StrView"                },
+	{ "(= (str-slice \"abcd\" 1 3) \"bc\")", "True"                },
+	{ "(set-list (Set \"bc\" (str-slice \"abc\" 1)))", "[\"bc\"]"  },
+	{ "(str-join (str-split \"a-b-c\" \"-\") \"+\")", "\"a+b+c\"" },
+	{ "(Str (str-slice \"hello\" 1 3) 'p)", "\"elp\""              },
+	{ "(str-upper \"Hello, World\")", "\"HELLO, WORLD\""           },
+	{ "(str-lower 'ABC)",              "\"abc\""                    },
+	{ "(def u \"héllo wörld €𝄞!\")",     "Void" },
+	{ "(strlen u)",                      "22" },
+	{ "(str-length u)",                  "15" },
+	{ "(char-at u 1)",                   "\"é\"" },
+	{ "(char-at u -2)",                  "\"𝄞\"" },
+	{ "(substr u 6 11)",                 "\"wörld\"" },
+	{ "(substr u -3)",                   "\"€𝄞!\"" },
+	{ "(str-length (substr u 1 4))",     "3" },
+	{ "(str-codes \"aé€𝄞\")",            "[97 233 8364 119070]" },
+	{ "(str-from-codes [97 233 8364 119070])", "\"aé€𝄞\"" },
+	{ "(str-valid? u)",                  "True" },
+	{ "(str-valid? (Str (str-slice u 1 2)))", "Nil" },
+	{ "(do (def s (Str (str-join (str-split (display (range 1 3000))) \"é\"))) [(str-length s) (char-at s 10000)])", "[13894 \"2\"]" },
+	{ "(do (def v (str-slice \"xéaéb\" 1)) [(char-at v 2) (char-at v 1) (str-length v) (substr v 1 3)])", "[\"é\" \"a\" 4 \"aé\"]" },
+	{ "(do (def λ 3) (* λ 2))",          "6" },
+	{ "(StrBuf \"a\" 1 'b)",             "(StrBuf \"a1b\")"            },
+	{ "(do (def b (StrBuf)) (strbuf-add! b \"x\" 2 [3]) (strbuf-add! b b) (Str b))", "\"x23x23\"" },
+	{ "(do (strbuf-clear! b) (strlen b))", "0"                        },
+	{ "(Rope \"ab\" \"cd\")",             "(Rope \"abcd\")"             },
+	{ "(Rope)",                        "(Rope \"\")"                 },
+	{ "(strlen (Rope (Rope \"abc\" 12) 'f))", "6"                      },
+	{ "(= (Rope \"ab\" \"c\") (Rope \"a\" \"bc\"))", "True"             },
+	{ "(do (def r (Rope)) (for i in 1..10000 (def r (Rope r \"ab\"))) (strlen (Str r)))", "20000" },
+	{ "(do (def r (Rope \"x\" \"y\")) (Str r) (Str (Rope r r)))", "\"xyxy\"" },
+	{ "(= (Rope \"a\" \"b\") \"ab\" (StrBuf \"ab\") (str-slice \"xab\" 1))", "True" },
+	{ "(= (StrBuf \"ab\") \"abc\")",     "Nil"                         },
+	{ "(map-get (Map \"ab\" 1) (Rope \"a\" \"b\"))", "1"                },
+	{ "(map-len (Set \"ab\" (StrBuf \"ab\") (Rope \"a\" \"b\")))", "1"  },
+	{ "(strlen (display (range 1 10000)))", "48895"                 },
 
 	{ "strfmt",                             NULL                              },
 	{ "(strfmt \"foo\")",                "\"foo\""                         },
@@ -111,11 +164,50 @@ char *tests[][2] = {
 	{ "(def ship \"planet express\")",      "Void"                            },
 	{ "f\"all aboard {ship}!!\")",          "\"all aboard planet express!!\"" },
 	{ "f\"4! = {factorial(4)}\")",          "\"4! = 24\""                     },
+	{ "f\"{ship}\"",                       "\"planet express\""              },
+	{ "f\"{{ship}} {(+ 1 2)}{version}\"",  "\"{ship} 30.1\""                 },
+	{ "f\"no braces\"",                    "\"no braces\""                   },
+	{ "(= f\"{ship}\" \"planet express\")", "True"                            },
+	{ "f\"a}b}}\"",                        "\"a}b}\""                        },
+	{ "(eval '(strfmt 5))",                "Void"                            },
+	{ "(eval '(strfmt (list 1 2)))",       "Void"                            },
 	/* { "str tib",                       NULL         }, */
 	/* { "split(\"hey,there\" \",\")", "(hey there)" }, */
 	/* { "split(\"end of col-de-sac\" \" \")", "(end of col-de-sac)" }, */
 	/* { "split(\"end of col-de-sac\" \" -\")", "(end of col de sac)" }, */
 
+	{ "regex",                                     NULL                    },
+	{ "(def r (Regex \"a(b+)c|d\"))",              "Void" },
+	{ "r",                                         "(Regex \"a(b+)c|d\")" },
+	{ "(re-search r \"xxabbbcyy\")",               "\"abbbc\"" },
+	{ "(re-captures r \"xxabbbcyy\")",             "[\"abbbc\" \"bbb\"]" },
+	{ "(re-captures r \"xxdyy\")",                 "[\"d\" Nil]" },
+	{ "(re-captures r \"xyz\")",                   "Nil" },
+	{ "(re-search (Regex \"b\") \"abcb\" 2)",      "\"b\"" },
+	{ "(re-find-all (Regex \"[0-9]+\") \"a1 b22 c333\")", "[\"1\" \"22\" \"333\"]" },
+	{ "(re-find-all (Regex \"a*\") \"ab\")",       "[\"a\" \"\" \"\"]" },
+	{ "(re-find-all (Regex \"(?:ab)+\") \"abababxab\")", "[\"ababab\" \"ab\"]" },
+	{ "(re-match? (Regex \"a|ab\") \"ab\")",       "True" },
+	{ "(re-search (Regex \"a|ab\") \"ab\")",       "\"a\"" },
+	{ "(re-match? (Regex \"^\\\\d{3}-\\\\d{4}$\") \"555-1234\")", "True" },
+	{ "(re-match? (Regex \"\\\\d{3}-\\\\d{4}\") \"555-12345\")", "Nil" },
+	{ "(re-match? (Regex \"(a|b)*abb\") \"babaabb\")", "True" },
+	{ "(re-search (Regex \"o$\") \"foo\")",        "\"o\"" },
+	{ "(re-search (Regex \"^o\") \"foo\")",        "Nil" },
+	{ "(re-search (Regex \"[^a-c]+\") \"abcdefabc\")", "\"def\"" },
+	{ "(re-search (Regex \"x{2,3}\") \"xxxxx\")",  "\"xxx\"" },
+	{ "(re-search (Regex \"x{2,3}?\") \"xxxxx\")", "\"xx\"" },
+	{ "(re-search (Regex \"a.c\") \"a\\nc abc\")", "\"abc\"" },
+	{ "(re-captures (Regex \"(\\\\w+)@(\\\\w+)\\\\.com\") \"to bob@example.com\")", "[\"bob@example.com\" \"bob\" \"example\"]" },
+	{ "(re-search (Regex \"é+\") \"xééy\")",      "\"éé\"" },
+	{ "(re-find-all (Regex \".\") \"a€😀é\")",    "[\"a\" \"€\" \"😀\" \"é\"]" },
+	{ "(re-search (Regex \"[é]\") \"xéy\")",      "\"é\"" },
+	{ "(re-search (Regex \"[^é]+\") \"éaé€b\")",  "\"a\"" },
+	{ "(re-search (Regex \"[à-ê]+\") \"zéèàq\")", "\"éèà\"" },
+	{ "(re-search (Regex \"\\\\W+\") \"ab€é cd\")", "\"€é \"" },
+	{ "(re-find-all (Regex \"x*\") \"éé\")",      "[\"\" \"\" \"\"]" },
+	{ "(eval '(Regex \"\\\\bfoo\"))",               "Void" },
+
 	{ "records", NULL                                                                     },
 	{ "(Rec (thewire \"TV Show\"))",
 		"{ thewire: \"TV Show\" }"                                                    },
@@ -128,18 +220,18 @@ char *tests[][2] = {
 	{ "({ (mcnulty \"cop\") (omar 'robber) (stringer 34) } 'mcnulty)",
 		"\"cop\""                                                                     },
 	{ "{ snoop: (- 2024 1990) marlo: (Int 25.75) avon: () stringer: \"dead\" }",
-		"{ snoop: 34 stringer: \"dead\" avon: Nil marlo: 25 }"                        },
+		"{ snoop: 34 marlo: 25 avon: Nil stringer: \"dead\" }"                        },
 	{ "map(@it::name [{name: 'randy } {name: 'dukie} {name: 'micheal}])",
 		"['randy 'dukie 'micheal]"                                                    },
 	{ "(def rec {a: 1 b: 2 c: 3 d: 4 })", "Void"                                          },
 	{ "(def omar { name: \"Omar Little\"  age: (- 2008 1966)  alive: False })", "Void"    },
-	{ "rec",             "{ d: 4 c: 3 b: 2 a: 1 }"                                        },
+	{ "rec",             "{ a: 1 b: 2 c: 3 d: 4 }"                                        },
 	{ "rec::a",          "1"                                                              },
 	{ "rec::b",          "2"                                                              },
 	{ "rec::c",          "3"                                                              },
 	{ "rec::d",          "4"                                                              },
-	{ "(records rec)",   "[['d ... 4] ['c ... 3] ['b ... 2] ['a ... 1]]"                  },
-	{ "(records omar)",  "[['name ... \"Omar Little\"] ['alive] ['age ... 42]]"           },
+	{ "(records rec)",   "[['a ... 1] ['b ... 2] ['c ... 3] ['d ... 4]]"                  },
+	{ "(records omar)",  "[['name ... \"Omar Little\"] ['age ... 42] ['alive]]"           },
 	{ "omar('name)",     "\"Omar Little\""                                                },
 	{ "omar('age)",      "42"                                                             },
 	{ "omar('alive)",    "Nil"                                                            },
@@ -147,12 +239,33 @@ char *tests[][2] = {
 	/* { "(values rec)", "'(3 2 1)"                                                       }, */
 	{ "{ }",             "{ }"                                                            },
 	{ "(Rec)",           "{ }"                                                            },
+	{ "map(@it::x [{x: 1 y: 2} {y: 3 x: 4} {x: 5 y: 6} {z: 7 else: 0}])",
+		"[1 4 5 0]"                                                                   },
+	{ "map(@it::b [omar{ b: 1 } rec rec{ e: 5 } {b: 'x}])",
+		"[1 2 2 'x]"                                                                  },
 
 	{ "recmerge", NULL                                                },
 	{ "(recmerge rec { e: 5 })",
-		"{ d: 4 c: 3 b: 2 a: 1 e: 5 }"                            },
+		"{ a: 1 b: 2 c: 3 d: 4 e: 5 }"                            },
 	{ "omar{ height: (+ (* 5 12) 10) }",
-		"{ name: \"Omar Little\" alive: Nil age: 42 height: 70 }" },
+		"{ name: \"Omar Little\" age: 42 alive: Nil height: 70 }" },
+	{ "rec{ b: 'x }{ b: 'y }{ b: 'z }",
+		"{ a: 1 b: 'z c: 3 d: 4 }"                                },
+	{ "(do rec{ a: 0 } rec)",
+		"{ a: 1 b: 2 c: 3 d: 4 }"                                 },
+	{ "(length (records rec{ e: 5 f: 6 }))",  "6"                 },
+	{ "(do (def big {}) (for i in 1..100 (def big (recmerge big (eval [(quote Rec) [(Sym \"k\" i) i]])))) (length (records big)))",
+		"100"                                                     },
+	{ "(list big::k1 big::k37 big::k100)",    "[1 37 100]"        },
+	{ "({ aB: 1 b!: 2 } 'b!)",                "2"                 },
+	{ "(do (def col big{ aB: 1 b!: 2 }) (list col::aB col{ b!: 3 }::b! col::b!))",
+		"[1 3 2]"                                                 },
+	{ "{ a: 1 b: 2 }{ c: 3 d: 4 e: 5 f: 6 g: 7 h: 8 i: 9 }::a", "1" },
+	{ "(records { b: 1 a: 2 }{ c: 3 b: 4 })", "[['b ... 4] ['a ... 2] ['c ... 3]]" },
+	{ "{ h: 1 g: 2 f: 3 e: 4 d: 5 c: 6 b: 7 a: 8 }",
+		"{ h: 1 g: 2 f: 3 e: 4 d: 5 c: 6 b: 7 a: 8 }"             },
+	{ "{ h: 1 g: 2 f: 3 e: 4 }{ d: 5 c: 6 b: 7 a: 8 }",
+		"{ h: 1 g: 2 f: 3 e: 4 d: 5 c: 6 b: 7 a: 8 }"             },
 
 	{ "fst/rst",                                   NULL        },
 	{ "(fst (Pair 1 2))",                          "1"         },
@@ -209,6 +322,43 @@ char *tests[][2] = {
 	{ "(cond ((= 1 2) 1) (\"foo\" 2) (else 3))",       "2"       },
 	{ "(cond (() (+ 1 2)))",                           "Void"    },
 
+	{ "loops",                                              NULL      },
+	{ "(do (def n 0) (while (< n 5) (def n (+ n 1))) n)",   "5"       },
+	{ "(while Nil (+ 1 2))",                                "Void"    },
+	{ "(do (def s 0) (for i in 1..10 (def s (+ s i))) s)",  "55"      },
+	{ "(do (def s 0) (for i in 3 .. 1 (def s i)) s)",       "0"       },
+	{ "(do (def s 0) (for i in -2..s (def s (+ s i))) s)",  "-3"      },
+	{ "(do (for x in '(a b c) (def l x)) l)",               "'c"      },
+	{ "(for i in 1..100 (when (> i 3) (break i)))",         "4"       },
+	{ "(for x in '(4 5 6) (when (odd? x) (break x)))",      "5"       },
+	{ "(loop (break 7))",                                   "7"       },
+	{ "(loop (loop (break 1)) (break 2))",                  "2"       },
+	{ "(do (def n 0) (loop (def n (+ n 1)) (when (= n 3) (break))) n)", "3" },
+	{ "(do (def li 7) (for li in 0..2 li) li)",              "7"       },
+	{ "(do (for lk in 0..2 lk) (defined? lk))",             "Nil"     },
+	{ "(do (def l Nil) (for i in 1..3 (def l (Pair i l))) l)", "[3 2 1]" },
+	{ "(do (def fs Nil) (for i in 1..3 (def fs (Pair (Func () i) fs))) (map (Func (f) (f)) fs))",
+		"[3 2 1]" },
+	{ "(for i in 1..10 (for-each (Func (x) (when (= x i 3) (break x))) [1 2 3]))", "3" },
+	{ "(do (def (brk) (break 'inner)) (eval '(for j in 1..3 (brk))))", "Void" },
+
+	{ "catch",                                                  NULL    },
+	{ "(catch 'x 1 2)",                                         "2"     },
+	{ "(catch 'done (throw 'done 5) 6)",                        "5"     },
+	{ "(catch 'a (+ 1 (catch 'b (throw 'a 2))))",               "2"     },
+	{ "(catch 'a (+ 1 (catch 'b (throw 'b 2))))",               "3"     },
+	{ "(catch 1 (catch 2 (throw (+ 0 1) 'one)))",               "'one"  },
+	{ "(catch 'x (eval '(throw 'x 3)))",                        "3"     },
+	{ "(catch 'out (for i in 1..10 (when (= i 4) (throw 'out i))))", "4" },
+	{ "(loop (catch 'x (break 9)))",                            "9"     },
+	{ "(def (find-deep x t)"
+	  "  (cond ((= x t) (throw 'found t))"
+	  "        ((pair? t) (find-deep x (fst t)) (find-deep x (rst t)))))",
+	                                                            "Void"  },
+	{ "(catch 'found (find-deep 3 '((1 2) ((3) 4))) Nil)",      "3"     },
+	{ "(catch 'found (find-deep 5 '((1 2) ((3) 4))) Nil)",      "Nil"   },
+	{ "bt",                                                     "Nil"   },
+
 	{ "eq",                                          NULL   },
 	{ "(=)",                                         "True" },
 	{ "(= 1)",                                       "True" },
@@ -321,7 +471,8 @@ char *tests[][2] = {
 	{ "primitive?(def)",                               "Nil"   },
 	{ "specialform?(quote)",                           "True"  },
 	{ "specialform?(defmacro)",                        "Nil"   },
-	{ "function?(ffst)",                               "True"  },
+	{ "function?(last)",                               "True"  },
+	{ "primitive?(ffst)",                              "True"  },
 	{ "function?((Func (x) (+ x 2)))",                 "True"  },
 	{ "function?(cond)",                               "Nil"   },
 	{ "macro?(quasiquote)",                            "True"  },
@@ -329,10 +480,19 @@ char *tests[][2] = {
 	{ "macro?(map)",                                   "Nil"   },
 	{ "record?({a: 1 b: 2 })",                         "True"  },
 	{ "record?('((a . 1) (b . 2)))",                   "Nil"   },
+	{ "atom?('a)",                                     "True"  },
+	{ "atom?([1 2])",                                  "Nil"   },
+	{ "list?([1 2])",                                  "True"  },
+	{ "list?([1 2 ... 3])",                            "Nil"   },
+	{ "list?(Nil)",                                    "True"  },
+	{ "number?(1/2)",                                  "True"  },
+	{ "procedure?(map)",                               "True"  },
+	{ "boolean?(Nil)",                                 "True"  },
+	{ "true?('True)",                                  "Nil"   },
 
 	{ "procprops",       NULL                                                      },
 	{ "procprops(fst)",  "{ name: 'fst }"                                          },
-	{ "procprops(list)", "{ name: 'list body: [\"Create list\" 'lst] args: 'lst }" },
+	{ "procprops(list)", "{ name: 'list args: 'lst body: [\"Create list\" 'lst] }" },
 
 	{ "Func",                       NULL },
 	{ "((Func (x) x) 3)",           "3"  },
@@ -341,6 +501,61 @@ char *tests[][2] = {
 	{ "((Func (a b) (+ a b)) 2 2)", "4"  },
 	{ "((Func (mod it 4)) 5)",      "1"  },
 	{ "((Func () 5))",              "5"  },
+	{ "(((Func (x) @(+ x it)) 3) 4)",           "7" },
+	{ "(((Func (x y) (Func () (- x y))) 9 4))", "5" },
+	{ "((Func (n) (def (f i) (if (= i 0) 0 (+ n (f (- i 1))))) (f 3)) 2)",
+		"6" },
+	{ "(do (def cx 'global) ((Func () (def (g) cx) (def cx 'local) (g))))",
+		"'local" },
+	{ "((Func (n) (def (even? n) (if (= n 0) 'even (odd? (- n 1))))"
+	  "           (def (odd? n) (if (= n 0) 'odd (even? (- n 1))))"
+	  "           (even? n)) 3)",
+		"'odd" },
+	{ "(def (mkc n) (def g (Func () (+ n later))) (def later 1) g)",
+		                                           "Void" },
+	{ "(def c (mkc 5))",                               "Void" },
+	{ "(do (map sqr '(1 2 3)) (c))",                   "6"  },
+	{ "(def (deep n) (cond ((= n 0) 'ok) (else (when True (deep (- n 1))))))",
+		                                           "Void" },
+	{ "(deep 300000)",                                 "'ok" },
+	{ "(def (tsum n acc) (if (= n 0) acc (do (def t (+ acc n)) (tsum (- n 1) t))))",
+		                                           "Void" },
+	{ "(tsum 1000 0)",                                 "500500" },
+	{ "(def (fns n l) (if (= n 0) l (fns (- n 1) (Pair (Func () n) l))))",
+		                                           "Void" },
+	{ "(map @(it) (fns 3 Nil))",                       "[1 2 3]" },
+
+	{ "generic",                                         NULL      },
+	{ "(defgeneric (area s))",                           "Void"    },
+	{ "(defmethod (area (s Int)) (* s s))",              "Void"    },
+	{ "(defmethod (area (s Rec)) (* (s 'w) (s 'h)))",    "Void"    },
+	{ "(defmethod (area s) 0)",                          "Void"    },
+	{ "(area 3)",                                        "9"       },
+	{ "(area 4)",                                        "16"      },
+	{ "(area { w: 2 h: 5 })",                            "10"      },
+	{ "(area \"foo\")",                                  "0"       },
+	{ "(defmethod (area (s Int)) s)",                    "Void"    },
+	{ "(area 3)",                                        "3"       },
+	{ "(map area '(1 2.0 3))",                           "[1 0 3]" },
+	{ "(defgeneric (join a b))",                         "Void"    },
+	{ "(defmethod (join (a Str) (b Str)) (Str a b))",    "Void"    },
+	{ "(defmethod (join (a Int) b) (+ a 100))",          "Void"    },
+	{ "(defmethod (join (a Int) (b Int)) (+ a b))",      "Void"    },
+	{ "(join \"a\" \"b\")",                              "\"ab\""  },
+	{ "(join 1 'x)",                                     "101"     },
+	{ "(join 1 2)",                                      "3"       },
+	{ "(Type area)",                                     "Generic" },
+	{ "(procedure? join)",                               "True"    },
+	{ "(generic? join)",                                 "True"    },
+	{ "(generic? +)",                                    "Nil"     },
+	{ "(def (count-down n) (if (= n 0) 'done (step n)))", "Void"   },
+	{ "(defgeneric (step n))",                           "Void"    },
+	{ "(defmethod (step (n Int)) (count-down (- n 1)))", "Void"    },
+	{ "(count-down 200000)",                             "'done"   },
+	{ "(def (areas l) (map @(area it) l))",              "Void"    },
+	{ "(areas '(2 \"a\" 3 4.0))",                        "[2 0 3 0]" },
+	{ "(defmethod (area (s Int)) (+ s 1))",              "Void"    },
+	{ "(areas '(2 \"a\" 3 4.0))",                        "[3 0 4 0]" },
 
 	{ "Macro",                       NULL  },
 	{ "((Macro (x) x) 3)",           "3"   },
@@ -376,7 +591,11 @@ char *tests[][2] = {
 	{ "(defined? when)",             "True"    },
 	{ "(defined? apply)",            "True"    },
 
-	/* { "undefine!",                    NULL      }, */
+	{ "undefine!",                   NULL      },
+	{ "(do (def undef-x 1) (undefine! undef-x) (defined? undef-x))", "Nil" },
+	{ "(do (def undef-y 1) (undefine! undef-y)"
+	  "    (for i in 1..3000 (eval [(quote def) (Sym \"undef-\" i) i]))"
+	  "    (list undef-7 undef-2999 (defined? undef-y)))",            "[7 2999 Nil]" },
 
 	{ "control",                                              NULL      },
 	{ "(if True 1 2)",                                        "1"       },
@@ -477,8 +696,17 @@ char *tests[][2] = {
 	{ "((compose -) 5/3)",                                      "-5/3"                  },
 	{ "((compose - +) 5 6)",                                    "-11"                   },
 	{ "((compose sqrt Int *) 4.5 2)",                           "3"                     },
-	/* { "(foldr + 0 '(1 2 4 5))",                              "12"                    }, */
-	/* { "(foldr list 0 '(1 2 3 4))",                           "((((0 1) 2) 3) 4)"     }, */
+	{ "(map inc 5)",                                            "6"                     },
+	{ "(foldl + 0 '(1 2 4 5))",                                 "12"                    },
+	{ "(foldl list 0 '(1 2 3 4))",                              "[[[[0 1] 2] 3] 4]"     },
+	{ "(foldl + 0 Nil)",                                        "0"                     },
+	{ "(reduce * '(1 2 3 4 5))",                                "120"                   },
+	{ "(reduce + (map sqr '(1 2 3)))",                          "14"                    },
+	{ "(sum (filter odd? (map inc '(1 2 3 4 5 6))))",           "15"                    },
+	{ "(filter odd? (map sqr (filter positive? '(-3 1 2 3))))", "[1 9]"                 },
+	{ "(map inc (map dec [1 2 ... 3]))",                        "[1 2 ... 3]"           },
+	{ "(filter odd? (map inc [1 2 ... 3]))",                    "[3]"                   },
+	{ "(for-each inc '(1 2 3))",                                "Void"                  },
 
 	{ "list filter",                                         NULL                  },
 	{ "(filter positive? '(1 2 -4 5 -9 10))",                "[1 2 5 10]"          },
@@ -532,6 +760,156 @@ char *tests[][2] = {
 	{ "(every? \"a\" '(a 'a \"a\"))",                   "Nil"                },
 	{ "(every? 3 (list 3 (+ 1 2) (- 5 2)))",            "True"               },
 
+	{ "sort",                                           NULL                 },
+	{ "(sort Nil)",                                     "Nil"                },
+	{ "(sort '(3 1 2))",                                "[1 2 3]"            },
+	{ "(sort '(3 1/2 2.5 -1 0))",                       "[-1 0 1/2 2.5 3]"   },
+	{ "(sort '(3 1 2) >)",                              "[3 2 1]"            },
+	{ "(sort '(\"b\" \"c\" \"a\"))",                    "[\"a\" \"b\" \"c\"]"  },
+	{ "(sort #[3 1 2])",                                "#[1 2 3]"           },
+	{ "(sort (PVec 2 3 1) >)",                          "(PVec 3 2 1)"       },
+	{ "(sort '(\"ccc\" \"a\" \"bb\") < strlen)",          "[\"a\" \"bb\" \"ccc\"]" },
+	{ "(sort (str-split \"b a c\"))",                   "[\"a\" \"b\" \"c\"]"  },
+	{ "(map Str (sort (list \"ab\" (str-slice \"xa\" 1) (Rope \"a\" \"c\") (StrBuf \"aa\")) >))", "[\"ac\" \"ab\" \"aa\" \"a\"]" },
+	{ "(sort '((1 b) (0 a) (1 a) (0 c)) < fst)",        "[[0 'a] [0 'c] [1 'b] [1 'a]]" },
+	{ "(sort '((1 b) (0 a) (1 a) (0 c)) (Func (x y) (< (fst x) (fst y))))",
+		"[[0 'a] [0 'c] [1 'b] [1 'a]]"                                  },
+	{ "(sort '(b c a) (Func (x y) (= y 'c)))",          "['b 'a 'c]"         },
+	{ "(sort (map @(mod (* it 37) 101) (range 1 100)) >)",
+		"[100 99 98 97 96 95 94 93 92 91 90 89 88 87 86 85 84 83 82 81 80 79 78 77 76 75 74 73 72 71 70 69 68 67 66 65 64 63 62 61 60 59 58 57 56 55 54 53 52 51 50 49 48 47 46 45 44 43 42 41 40 39 38 37 36 35 34 33 32 31 30 29 28 27 26 25 24 23 22 21 20 19 18 17 16 15 14 13 12 11 10 9 8 7 6 5 4 3 2 1]" },
+
+	{ "vec",                                       NULL                    },
+	{ "#[]",                                       "#[]"                   },
+	{ "#[1 2 3]",                                  "#[1 2 3]"              },
+	{ "(Vec 'a \"b\" (+ 1 2))",                    "#['a \"b\" 3]"          },
+	{ "(def v #[10 20 30])",                       "Void"                  },
+	{ "(vec-ref v 0)",                             "10"                    },
+	{ "(vec-ref v 2)",                             "30"                    },
+	{ "(vec-len v)",                               "3"                     },
+	{ "(vec-set! v 1 'x)",                         "Void"                  },
+	{ "v",                                         "#[10 'x 30]"           },
+	{ "(vec-push! v 40 50)",                       "Void"                  },
+	{ "(vec-len v)",                               "5"                     },
+	{ "(vec-ref v 4)",                             "50"                    },
+	{ "(vec-list v)",                              "[10 'x 30 40 50]"      },
+	{ "(Type v)",                                  "Vec"                   },
+	{ "(vec? v)",                                  "True"                  },
+	{ "(vec? '(1 2))",                             "Nil"                   },
+	{ "(= #[1 2 3] (Vec 1 2 3))",                  "True"                  },
+	{ "(= #[1 2 3] #[1 2])",                       "Nil"                   },
+	{ "(= #[1 2 3] '(1 2 3))",                     "Nil"                   },
+	{ "(map sqr #[1 2 3])",                        "#[1 4 9]"              },
+	{ "(filter odd? (map inc #[1 2 3 4]))",        "#[3 5]"                },
+	{ "(foldl + 0 #[1 2 3 4])",                    "10"                    },
+	{ "(do (def s 0) (for x in #[4 5] (def s (+ s x))) s)", "9"            },
+	{ "(vec-ref #[1 2 3] -1)",                     "3"                     },
+	{ "(nth #[1 2 3] 1)",                          "2"                     },
+	{ "(length #[1 2 3])",                         "3"                     },
+
+	{ "pvec",                                      NULL                    },
+	{ "(PVec)",                                    "(PVec)"                },
+	{ "(PVec 1 \"b\" 'c)",                         "(PVec 1 \"b\" 'c)"     },
+	{ "(def pv (PVec 1 2 3))",                     "Void"                  },
+	{ "(pvec-nth pv 0)",                           "1"                     },
+	{ "(pvec-nth pv -1)",                          "3"                     },
+	{ "(pvec-assoc pv 1 'x)",                      "(PVec 1 'x 3)"         },
+	{ "(pvec-conj pv 4 5)",                        "(PVec 1 2 3 4 5)"      },
+	{ "pv",                                        "(PVec 1 2 3)"          },
+	{ "(pvec-len (pvec-assoc pv 3 4))",            "4"                     },
+	{ "(pvec-assoc pv -1 'x)",                     "(PVec 1 2 'x)"         },
+	{ "(pvec-assoc pv -3 'x)",                     "(PVec 'x 2 3)"         },
+	{ "(pvec-list pv)",                            "[1 2 3]"               },
+	{ "(Type pv)",                                 "PVec"                  },
+	{ "(pvec? pv)",                                "True"                  },
+	{ "(pvec? #[1 2 3])",                          "Nil"                   },
+	{ "(= pv (PVec 1 2 3))",                       "True"                  },
+	{ "(= pv (pvec-conj pv 4))",                   "Nil"                   },
+	{ "(map sqr pv)",                              "(PVec 1 4 9)"          },
+	{ "(length pv)",                               "3"                     },
+	{ "(last pv)",                                 "3"                     },
+	{ "(def big (foldl pvec-conj (PVec) (range 0 1999)))", "Void"          },
+	{ "(pvec-len big)",                            "2000"                  },
+	{ "(pvec-nth big 1056)",                       "1056"                  },
+	{ "(pvec-nth (pvec-assoc big 1500 'x) 1500)",  "'x"                    },
+	{ "(pvec-nth big 1500)",                       "1500"                  },
+	{ "(foldl + 0 big)",                           "1999000"               },
+
+	{ "map/set",                                   NULL                    },
+	{ "(Map)",                                     "(Map)"                 },
+	{ "(Map 1 'a \"b\" 2)",                        "(Map 1 'a \"b\" 2)"    },
+	{ "(def m (Map 1 'a [1 2] 'b #[3] 'c))",       "Void"                  },
+	{ "(map-get m 1)",                             "'a"                    },
+	{ "(map-get m 1.0)",                           "'a"                    },
+	{ "(map-get m [1 2])",                         "'b"                    },
+	{ "(map-get m #[3])",                          "'c"                    },
+	{ "(map-get m 'x)",                            "Nil"                   },
+	{ "(map-get m 'x 0)",                          "0"                     },
+	{ "(map-put! m 1 'z)",                         "Void"                  },
+	{ "(map-put! m \"s\" 'd)",                     "Void"                  },
+	{ "(has? m \"s\")",                            "True"                  },
+	{ "(has? m 's)",                               "Nil"                   },
+	{ "(del! m [1 2] 'x)",                         "Void"                  },
+	{ "(has? m [1 2])",                            "Nil"                   },
+	{ "m",                                         "(Map 1 'z #[3] 'c \"s\" 'd)" },
+	{ "(map-keys m)",                              "[1 #[3] \"s\"]"        },
+	{ "(map-vals m)",                              "['z 'c 'd]"            },
+	{ "(map-list (Map 1 2))",                      "[[1 ... 2]]"           },
+	{ "(map-len m)",                               "3"                     },
+	{ "(length m)",                                "3"                     },
+	{ "(map-get (map-from [[1 ... 2] [3 ... 4]]) 3)", "4"                  },
+	{ "(Type m)",                                  "Map"                   },
+	{ "(map? m)",                                  "True"                  },
+	{ "(= (Map 1 2 3 4) (Map 3 4 1 2))",           "True"                  },
+	{ "(= (Map 1 2) (Map 1 3))",                   "Nil"                   },
+	{ "(do (def m (Map)) (for i in 1..1000 (map-put! m (* i i) i)) (for i in 1..500 (del! m (* i i))) (list (map-len m) (map-get m 251001) (map-get m 1000000) (map-get m 4)))",
+		"[500 501 1000 Nil]"                                           },
+	{ "(Set)",                                     "(Set)"                 },
+	{ "(Set 1 2 2 1 'a)",                          "(Set 1 2 'a)"          },
+	{ "(set-from [3 1 3 [1] [1]])",                "(Set 3 1 [1])"         },
+	{ "(def s (Set 1 2))",                         "Void"                  },
+	{ "(set-add! s 3 1)",                          "Void"                  },
+	{ "(has? s 3)",                                "True"                  },
+	{ "(del! s 1)",                                "Void"                  },
+	{ "(set-list s)",                              "[2 3]"                 },
+	{ "(length s)",                                "2"                     },
+	{ "(set? s)",                                  "True"                  },
+	{ "(= (Set 1 2) (Set 2 1))",                   "True"                  },
+	{ "(map-get (Map (Set 1 2) 'x) (Set 2 1))",    "'x"                    },
+
+	{ "numarray",                                  NULL                    },
+	{ "(NumArray)",                                "(NumArray)"            },
+	{ "(NumArray 1 2.5 1/2)",                      "(NumArray 1.0 2.5 0.5)" },
+	{ "(def a (arr-from [1 2 3 4]))",              "Void"                  },
+	{ "(arr-ref a 0)",                             "1.0"                   },
+	{ "(arr-ref a -1)",                            "4.0"                   },
+	{ "(do (arr-set! a 1 7) a)",                   "(NumArray 1.0 7.0 3.0 4.0)" },
+	{ "(arr-set! a 1 2)",                          "Void"                  },
+	{ "(arr-len a)",                               "4"                     },
+	{ "(length a)",                                "4"                     },
+	{ "(arr-list a)",                              "[1.0 2.0 3.0 4.0]"     },
+	{ "(arr-fill 3 1/4)",                          "(NumArray 0.25 0.25 0.25)" },
+	{ "(= (arr-range 1 4) a)",                     "True"                  },
+	{ "(= (NumArray 1 2) (NumArray 1 3))",         "Nil"                   },
+	{ "(arr-add a a)",                             "(NumArray 2.0 4.0 6.0 8.0)" },
+	{ "(arr-sub 10 a)",                            "(NumArray 9.0 8.0 7.0 6.0)" },
+	{ "(arr-mul a 1/2)",                           "(NumArray 0.5 1.0 1.5 2.0)" },
+	{ "(arr-div a (arr-fill 4 2))",                "(NumArray 0.5 1.0 1.5 2.0)" },
+	{ "(arr-sum a)",                               "10.0"                  },
+	{ "(arr-sum (NumArray))",                      "0.0"                   },
+	{ "(arr-sum (arr-range 1 1001))",              "501501.0"              },
+	{ "(arr-dot a (arr-range 5 8))",               "70.0"                  },
+	{ "(arr-min (NumArray 3 -1 2))",               "-1.0"                  },
+	{ "(arr-max (NumArray 3 -1 2))",               "3.0"                   },
+	{ "(arr-mean a)",                              "2.5"                   },
+	{ "(arr-sqrt (NumArray 4 9))",                 "(NumArray 2.0 3.0)"    },
+	{ "(arr-exp (NumArray 0))",                    "(NumArray 1.0)"        },
+	{ "(map @(* it it) a)",                        "(NumArray 1.0 4.0 9.0 16.0)" },
+	{ "(filter @(> it 2) a)",                      "(NumArray 3.0 4.0)"    },
+	{ "(sort (NumArray 3 1 2))",                   "(NumArray 1.0 2.0 3.0)" },
+	{ "(Type a)",                                  "NumArray"              },
+	{ "(numarray? a)",                             "True"                  },
+	{ "(numarray? [1 2])",                         "Nil"                   },
+
 	{ "quasiquote",               NULL                 },
 	{ "`7.2",                     "7.2"                },
 	{ "`cory",                    "'cory"              },
@@ -663,6 +1041,50 @@ char *tests[][2] = {
 	{ "(mod 7 2)",    "1"  },
 	{ "(mod 8 5)",    "3"  },
 
+	{ "symbolic",                                   NULL                   },
+	{ "(sqrt 2)",                                   "['^ 2 1/2]"           },
+	{ "(sin 1)",                                    "['sin 1]"             },
+	{ "(sin 0)",                                    "0"                    },
+	{ "(log (exp 'x))",                             "'x"                   },
+	{ "(+ 'x 1)",                                   "['+ 1 'x]"            },
+	{ "(+ 1 (+ 2 'x))",                             "['+ 3 'x]"            },
+	{ "(- 'x 'x)",                                  "0"                    },
+	{ "(- 'x)",                                     "['* -1 'x]"           },
+	{ "(/ 'x 2)",                                   "['* 1/2 'x]"          },
+	{ "(/ 'x 0.5)",                                 "['* 2.0 'x]"          },
+	{ "(eval '(/ (sin 2) 0))",                      "Void"                 },
+	{ "(eval '(/ 'x 0.0))",                         "Void"                 },
+	{ "(eval '(/ 'x 0.0))",                         "Void"                 },
+	{ "(eval '(+ (list 1) 1))",                     "Void"                 },
+	{ "(eval '(sin (list 1)))",                     "Void"                 },
+	{ "(eval '(^ (list 1) 2))",                     "Void"                 },
+	{ "(eval '(* (list 1 2) 2))",                   "Void"                 },
+	{ "(eval '(simplify '(foo x)))",                "Void"                 },
+	{ "(* '(+ x 1) 2)",                             "['* 2 ['+ 1 'x]]"     },
+	{ "(+ 1 '(+ 2))",                               "['+ 1 ['+ 2]]"        },
+	{ "(eval '(sin '(asin x y)))",                  "Void"                 },
+	{ "(* 0 (sin 'y))",                             "0"                    },
+	{ "(* (sqrt 2) (sqrt 2))",                      "2"                    },
+	{ "(^ (^ 'x 2) 3)",                             "['^ 'x 6]"            },
+	{ "(+ (sin 'x) (sin 'x))",                      "['* 2 ['sin 'x]]"     },
+	{ "(simplify '(+ (* 1 x) 0))",                  "'x"                   },
+	{ "(simplify '(* (+ 1 2) (^ 4 1/2)))",          "6"                    },
+	{ "(= (sin 'x) '(sin x))",                      "True"                 },
+	{ "(do (def e 'x) (for i in 1..60 (def e (* (+ e 1) (+ e 2)))) (= e (simplify (list '* (+ e 0) 1))))",
+		"True"                                                          },
+	{ "((lambdify '(x y) (+ (* 'x 'x) (sin 'y))) 3 0)", "9.0"              },
+	{ "((lambdify '(x) '(+ x 1 2 3)) 4)",           "10.0"                 },
+	{ "((lambdify '(x) '(- x)) 2)",                 "-2.0"                 },
+	{ "((lambdify '(x) '(/ x)) 4)",                 "0.25"                 },
+	{ "((lambdify '(x) (sqrt 'x)) 16)",             "4.0"                  },
+	{ "((lambdify () 7))",                          "7.0"                  },
+	{ "((lambdify '(x y) '(* x y)) (arr-range 1 3) 2)", "(NumArray 2.0 4.0 6.0)" },
+	{ "(map (lambdify '(x) '(* x x)) [1 2 3])",     "[1.0 4.0 9.0]"        },
+	{ "((NumFunc '(x) '(exp x)) 0)",                "1.0"                  },
+	{ "(numfunc? (lambdify '(x) 'x))",              "True"                 },
+	{ "(procedure? (lambdify '(x) 'x))",            "True"                 },
+	{ "(Type (lambdify '(x) 'x))",                  "NumFunc"              },
+
 	{ "compare",      NULL   },
 	{ "(< 2 3)",      "True" },
 	{ "(< 3 3)",      "Nil"  },